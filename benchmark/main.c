@@ -0,0 +1,275 @@
+#include <libint.h>
+
+#include <assert.h>
+#include <stdio.h>
+#include <time.h>
+
+static Libint *libint;
+
+// A number of exactly the given size in bits. Parsing is avoided, so that big operands are cheap to build: a power
+// of a 30-bit base has at least 29 bits per factor and is cut down to size.
+static LibintUnsigned *random_unsigned(size_t bits) {
+    LibintError err;
+    LibintUnsigned *base;
+    uintmax_t base_value = ((uintmax_t) 1 << 29) | (((uintmax_t) rand() << 15) ^ (uintmax_t) rand()) | 1;
+    err = libint_unsigned_create(libint, &base, base_value & (((uintmax_t) 1 << 30) - 1));
+    assert(LIBINT_ERROR_OK == err);
+    LibintUnsigned *x;
+    err = libint_unsigned_pow(libint, &x, base, bits / 29 + 1);
+    assert(LIBINT_ERROR_OK == err);
+    libint_unsigned_destroy(libint, &base);
+    size_t msb;
+    err = libint_unsigned_most_significant_bit(libint, x, &msb);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_unsigned_bitshift_replace(libint, &x, -(int) (msb + 1 - bits));
+    assert(LIBINT_ERROR_OK == err);
+    return x;
+}
+
+// Sizes in bits that alternate between powers of two and 1.5 times them. Transforms pad to a power of two, so that
+// both their best and their worst case show.
+static size_t next_bits(size_t bits) {
+    return bits % 3 ? bits / 2 * 3 : bits / 3 * 4;
+}
+
+// Average time of one multiplication in microseconds.
+static double time_mul(LibintUnsigned *x, LibintUnsigned *y) {
+    LibintError err;
+    int repetitions = 0;
+    clock_t start = clock();
+    clock_t elapsed;
+    do {
+        LibintUnsigned *product;
+        err = libint_unsigned_mul(libint, &product, x, y);
+        assert(LIBINT_ERROR_OK == err);
+        libint_unsigned_destroy(libint, &product);
+        ++repetitions;
+        elapsed = clock() - start;
+    } while (elapsed < CLOCKS_PER_SEC / 4);
+    return (double) elapsed / CLOCKS_PER_SEC / repetitions * 1e6;
+}
+
+// Average time of one division with remainder in microseconds.
+static double time_div_mod(LibintUnsigned *x, LibintUnsigned *y) {
+    LibintError err;
+    int repetitions = 0;
+    clock_t start = clock();
+    clock_t elapsed;
+    do {
+        LibintUnsigned *quotient, *remainder;
+        err = libint_unsigned_div_mod(libint, &quotient, &remainder, x, y);
+        assert(LIBINT_ERROR_OK == err);
+        libint_unsigned_destroy(libint, &quotient);
+        libint_unsigned_destroy(libint, &remainder);
+        ++repetitions;
+        elapsed = clock() - start;
+    } while (elapsed < CLOCKS_PER_SEC / 4);
+    return (double) elapsed / CLOCKS_PER_SEC / repetitions * 1e6;
+}
+
+// Average time of one division with remainder by a divider in microseconds.
+static double time_divider_div_mod(LibintUnsigned *x, LibintDivider *y) {
+    LibintError err;
+    int repetitions = 0;
+    clock_t start = clock();
+    clock_t elapsed;
+    do {
+        LibintUnsigned *quotient, *remainder;
+        err = libint_divider_div_mod(libint, &quotient, &remainder, x, y);
+        assert(LIBINT_ERROR_OK == err);
+        libint_unsigned_destroy(libint, &quotient);
+        libint_unsigned_destroy(libint, &remainder);
+        ++repetitions;
+        elapsed = clock() - start;
+    } while (elapsed < CLOCKS_PER_SEC / 4);
+    return (double) elapsed / CLOCKS_PER_SEC / repetitions * 1e6;
+}
+
+// Average time of one greatest common divisor in microseconds.
+static double time_gcd(LibintUnsigned *x, LibintUnsigned *y) {
+    LibintError err;
+    int repetitions = 0;
+    clock_t start = clock();
+    clock_t elapsed;
+    do {
+        LibintUnsigned *gcd;
+        err = libint_unsigned_gcd(libint, &gcd, x, y);
+        assert(LIBINT_ERROR_OK == err);
+        libint_unsigned_destroy(libint, &gcd);
+        ++repetitions;
+        elapsed = clock() - start;
+    } while (elapsed < CLOCKS_PER_SEC / 4);
+    return (double) elapsed / CLOCKS_PER_SEC / repetitions * 1e6;
+}
+
+// Compares Toom-3 with number-theoretic transform multiplication on balanced operands.
+static void benchmark_mul_ntt(void) {
+    LibintError err;
+
+    size_t ntt_threshold;
+    err = libint_get_threshold(libint, LIBINT_THRESHOLD_MUL_NTT, &ntt_threshold);
+    assert(LIBINT_ERROR_OK == err);
+
+    printf("%10s %14s %14s\n", "bits", "toom3, us", "ntt, us");
+    for (size_t bits = 1 << 12; bits <= 1 << 24; bits = next_bits(bits)) {
+        LibintUnsigned *x = random_unsigned(bits);
+        LibintUnsigned *y = random_unsigned(bits);
+
+        err = libint_set_threshold(libint, LIBINT_THRESHOLD_MUL_NTT, SIZE_MAX);
+        assert(LIBINT_ERROR_OK == err);
+        double toom3_time = time_mul(x, y);
+
+        err = libint_set_threshold(libint, LIBINT_THRESHOLD_MUL_NTT, 1);
+        assert(LIBINT_ERROR_OK == err);
+        double ntt_time = time_mul(x, y);
+
+        printf("%10zu %14.1f %14.1f\n", bits, toom3_time, ntt_time);
+        fflush(stdout);
+
+        libint_unsigned_destroy(libint, &x);
+        libint_unsigned_destroy(libint, &y);
+    }
+
+    err = libint_set_threshold(libint, LIBINT_THRESHOLD_MUL_NTT, ntt_threshold);
+    assert(LIBINT_ERROR_OK == err);
+}
+
+// Compares schoolbook, Burnikel-Ziegler and Newton division of 2n by n bits with n by n bits multiplication. The
+// factors of the multiplication differ, a square is cheaper.
+static void benchmark_div(void) {
+    LibintError err;
+
+    size_t threshold;
+    err = libint_get_threshold(libint, LIBINT_THRESHOLD_DIV_BURNIKEL_ZIEGLER, &threshold);
+    assert(LIBINT_ERROR_OK == err);
+    size_t newton_threshold;
+    err = libint_get_threshold(libint, LIBINT_THRESHOLD_DIV_NEWTON, &newton_threshold);
+    assert(LIBINT_ERROR_OK == err);
+
+    printf("%10s %14s %14s %14s %14s\n", "bits", "mul, us", "schoolbook, us", "recursive, us", "newton, us");
+    for (size_t bits = 1 << 11; bits <= 1 << 24; bits = next_bits(bits)) {
+        LibintUnsigned *x = random_unsigned(2 * bits);
+        LibintUnsigned *y = random_unsigned(bits);
+        LibintUnsigned *z = random_unsigned(bits);
+
+        double mul_time = time_mul(y, z);
+
+        double schoolbook_time = 0;
+        if (bits <= 1 << 18) {
+            err = libint_set_threshold(libint, LIBINT_THRESHOLD_DIV_BURNIKEL_ZIEGLER, SIZE_MAX);
+            assert(LIBINT_ERROR_OK == err);
+            schoolbook_time = time_div_mod(x, y);
+        }
+
+        err = libint_set_threshold(libint, LIBINT_THRESHOLD_DIV_BURNIKEL_ZIEGLER, threshold);
+        assert(LIBINT_ERROR_OK == err);
+        err = libint_set_threshold(libint, LIBINT_THRESHOLD_DIV_NEWTON, SIZE_MAX);
+        assert(LIBINT_ERROR_OK == err);
+        double recursive_time = time_div_mod(x, y);
+
+        err = libint_set_threshold(libint, LIBINT_THRESHOLD_DIV_NEWTON, 3);
+        assert(LIBINT_ERROR_OK == err);
+        double newton_time = time_div_mod(x, y);
+
+        printf("%10zu %14.1f %14.1f %14.1f %14.1f\n", bits, mul_time, schoolbook_time, recursive_time, newton_time);
+        fflush(stdout);
+
+        libint_unsigned_destroy(libint, &x);
+        libint_unsigned_destroy(libint, &y);
+        libint_unsigned_destroy(libint, &z);
+    }
+
+    err = libint_set_threshold(libint, LIBINT_THRESHOLD_DIV_NEWTON, newton_threshold);
+    assert(LIBINT_ERROR_OK == err);
+}
+
+// Compares division of 2n by n bits by a divider created beforehand, without and with a Newton reciprocal, with the
+// plain division.
+static void benchmark_divider(void) {
+    LibintError err;
+
+    size_t threshold;
+    err = libint_get_threshold(libint, LIBINT_THRESHOLD_DIVIDER_NEWTON, &threshold);
+    assert(LIBINT_ERROR_OK == err);
+
+    printf("%10s %14s %14s %14s\n", "bits", "div_mod, us", "divider, us", "newton, us");
+    for (size_t bits = 1 << 10; bits <= 1 << 20; bits = next_bits(bits)) {
+        LibintUnsigned *x = random_unsigned(2 * bits);
+        LibintUnsigned *y = random_unsigned(bits);
+
+        double div_mod_time = time_div_mod(x, y);
+
+        err = libint_set_threshold(libint, LIBINT_THRESHOLD_DIVIDER_NEWTON, SIZE_MAX);
+        assert(LIBINT_ERROR_OK == err);
+        LibintDivider *divider;
+        err = libint_divider_create(libint, &divider, y);
+        assert(LIBINT_ERROR_OK == err);
+        double divider_time = time_divider_div_mod(x, divider);
+        libint_divider_destroy(libint, &divider);
+
+        err = libint_set_threshold(libint, LIBINT_THRESHOLD_DIVIDER_NEWTON, 3);
+        assert(LIBINT_ERROR_OK == err);
+        err = libint_divider_create(libint, &divider, y);
+        assert(LIBINT_ERROR_OK == err);
+        double newton_time = time_divider_div_mod(x, divider);
+        libint_divider_destroy(libint, &divider);
+
+        printf("%10zu %14.1f %14.1f %14.1f\n", bits, div_mod_time, divider_time, newton_time);
+        fflush(stdout);
+
+        libint_unsigned_destroy(libint, &x);
+        libint_unsigned_destroy(libint, &y);
+    }
+
+    err = libint_set_threshold(libint, LIBINT_THRESHOLD_DIVIDER_NEWTON, threshold);
+    assert(LIBINT_ERROR_OK == err);
+}
+
+// Compares Lehmer's greatest common divisor with half-GCD.
+static void benchmark_gcd(void) {
+    LibintError err;
+
+    size_t threshold;
+    err = libint_get_threshold(libint, LIBINT_THRESHOLD_GCD_HALF_GCD, &threshold);
+    assert(LIBINT_ERROR_OK == err);
+
+    printf("%10s %14s %14s\n", "bits", "lehmer, us", "half-gcd, us");
+    for (size_t bits = 1 << 14; bits <= 1 << 22; bits *= 2) {
+        LibintUnsigned *x = random_unsigned(bits);
+        LibintUnsigned *y = random_unsigned(bits);
+
+        double lehmer_time = 0;
+        if (bits <= 1 << 19) {
+            err = libint_set_threshold(libint, LIBINT_THRESHOLD_GCD_HALF_GCD, SIZE_MAX);
+            assert(LIBINT_ERROR_OK == err);
+            lehmer_time = time_gcd(x, y);
+        }
+
+        err = libint_set_threshold(libint, LIBINT_THRESHOLD_GCD_HALF_GCD, 4);
+        assert(LIBINT_ERROR_OK == err);
+        double half_gcd_time = time_gcd(x, y);
+
+        printf("%10zu %14.1f %14.1f\n", bits, lehmer_time, half_gcd_time);
+        fflush(stdout);
+
+        libint_unsigned_destroy(libint, &x);
+        libint_unsigned_destroy(libint, &y);
+    }
+
+    err = libint_set_threshold(libint, LIBINT_THRESHOLD_GCD_HALF_GCD, threshold);
+    assert(LIBINT_ERROR_OK == err);
+}
+
+int main() {
+    LibintError err = libint_start(&libint);
+    assert(LIBINT_ERROR_OK == err);
+
+    srand(42);
+    benchmark_mul_ntt();
+    benchmark_div();
+    benchmark_divider();
+    benchmark_gcd();
+
+    libint_finish(&libint);
+    return EXIT_SUCCESS;
+}
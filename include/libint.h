@@ -5,9 +5,25 @@
 #include <stdlib.h>
 #include <stdbool.h>
 
+#include "libint_config.h"
+
+// Machine word in which magnitudes are stored. LIBINT_64_BIT_WORDS is defined by libint_config.h, which the build
+// generates, if the library uses 64-bit words.
+#ifdef LIBINT_64_BIT_WORDS
+typedef uint64_t LibintWord;
+#else
+typedef uint32_t LibintWord;
+#endif
+
 typedef struct Libint_ Libint;
 typedef struct LibintUnsigned_ LibintUnsigned;
 typedef struct LibintSigned_ LibintSigned;
+// Divisor prepared for repeated division.
+typedef struct LibintDivider_ LibintDivider;
+// Odd modulus prepared for Montgomery multiplication.
+typedef struct LibintMontgomery_ LibintMontgomery;
+// Modulus prepared for Barrett reduction.
+typedef struct LibintBarrett_ LibintBarrett;
 
 typedef enum {
     LIBINT_ERROR_OK,
@@ -20,10 +36,73 @@ typedef enum {
     LIBINT_ERROR_IO,
 } LibintError;
 
+// Source of memory for numbers. Every function gets state as its first argument. Strings returned by the library
+// are always allocated by malloc.
+typedef struct {
+    void *(*allocate)(void *state, size_t size);
+    void *(*reallocate)(void *state, void *ptr, size_t size);
+    void (*deallocate)(void *state, void *ptr);
+    void *state;
+} LibintAllocator;
+
+// Allocator that uses malloc, realloc and free.
+extern const LibintAllocator libint_system_allocator;
+
+// Operand sizes (in words) starting from which the corresponding algorithm is used.
+typedef enum {
+    // Karatsuba multiplication, at least 2.
+    LIBINT_THRESHOLD_MUL_KARATSUBA,
+    // Toom-Cook 3-way multiplication, at least 3.
+    LIBINT_THRESHOLD_MUL_TOOM3,
+    // Number-theoretic transform multiplication and squaring, at least 1.
+    LIBINT_THRESHOLD_MUL_NTT,
+    // Karatsuba squaring, at least 2.
+    LIBINT_THRESHOLD_SQR_KARATSUBA,
+    // Toom-Cook 3-way squaring, at least 3.
+    LIBINT_THRESHOLD_SQR_TOOM3,
+    // Burnikel-Ziegler division, both the divisor and the quotient must be that long, at least 2.
+    LIBINT_THRESHOLD_DIV_BURNIKEL_ZIEGLER,
+    // Division by Newton reciprocal, both the divisor and the quotient must be that long, at least 3.
+    LIBINT_THRESHOLD_DIV_NEWTON,
+    // Divisor length from which a divider keeps a Newton reciprocal and divides by it, at least 3. The reciprocal is
+    // computed once, so this is much lower than LIBINT_THRESHOLD_DIV_NEWTON.
+    LIBINT_THRESHOLD_DIVIDER_NEWTON,
+    // Conversion to string by splitting the number with cached powers of the base, at least 2.
+    LIBINT_THRESHOLD_TO_STRING_RECURSIVE,
+    // Parsing by splitting the input and combining the halves with cached powers of the base, in words, at least 2.
+    LIBINT_THRESHOLD_FROM_STRING_RECURSIVE,
+    // Lehmer's greatest common divisor instead of the binary one, at least 1.
+    LIBINT_THRESHOLD_GCD_LEHMER,
+    // Greatest common divisor by half-GCD instead of Lehmer's algorithm, at least 4.
+    LIBINT_THRESHOLD_GCD_HALF_GCD,
+    // Half-GCD of the leading half of the numbers by recursion instead of Lehmer steps, at least 4.
+    LIBINT_THRESHOLD_HALF_GCD_RECURSIVE,
+} LibintThreshold;
+
+// The fastest word kernels for the processor, such as ones with the ADX and BMI2 instructions on x86-64, are chosen
+// once when the program is loaded. The environment variable LIBINT_KERNELS=portable makes libint use the portable C
+// ones.
 LibintError libint_start(Libint **libint);
 
+LibintError libint_start_with_allocator(Libint **libint, const LibintAllocator *allocator);
+
 LibintError libint_finish(Libint **libint);
 
+// Places numbers created from now on into an arena of chunks of at least chunk_size bytes taken from the allocator.
+// Destroying them costs almost nothing.
+LibintError libint_arena_begin(Libint *libint, size_t chunk_size);
+
+// Frees all the numbers in the arena at once. They may not be used or destroyed afterwards. Numbers created before
+// the arena keep their memory outside of it, even if they grow or are replaced while it is in use.
+LibintError libint_arena_reset(Libint *libint);
+
+// Resets the arena and stops placing numbers into it.
+LibintError libint_arena_end(Libint *libint);
+
+LibintError libint_get_threshold(Libint *libint, LibintThreshold threshold, size_t *value);
+
+LibintError libint_set_threshold(Libint *libint, LibintThreshold threshold, size_t value);
+
 LibintError libint_create(Libint *libint, LibintSigned **x, intmax_t value);
 
 LibintError libint_to_intmax(Libint *libint, LibintSigned *x, intmax_t *value);
@@ -33,6 +112,9 @@ LibintError libint_from_string(Libint *libint, LibintSigned **x, const char *inp
 
 LibintError libint_to_string(Libint *libint, LibintSigned *x, int base, char **out, size_t *out_size);
 
+// Takes O(1) time, the copy shares memory with x until one of them is modified. x is updated to count the sharing,
+// so it may not be copied by several threads at once. The count is atomic, so numbers sharing memory may be modified
+// and destroyed on different threads. The copy is made at once if only one of them is in an arena.
 LibintError libint_copy(Libint *libint, LibintSigned **out, LibintSigned *x);
 
 LibintError libint_destroy(Libint *libint, LibintSigned **x);
@@ -43,6 +125,8 @@ LibintError libint_sub(Libint *libint, LibintSigned **out, LibintSigned *x, Libi
 
 LibintError libint_mul(Libint *libint, LibintSigned **out, LibintSigned *x, LibintSigned *y);
 
+LibintError libint_sqr(Libint *libint, LibintSigned **out, LibintSigned *x);
+
 LibintError libint_div_trunc(Libint *libint, LibintSigned **out, LibintSigned *x, LibintSigned *y);
 
 LibintError libint_mod_trunc(Libint *libint, LibintSigned **out, LibintSigned *x, LibintSigned *y);
@@ -57,6 +141,38 @@ LibintError libint_mod_floor(Libint *libint, LibintSigned **out, LibintSigned *x
 LibintError libint_div_mod_floor(
         Libint *libint, LibintSigned **quotient, LibintSigned **remainder, LibintSigned *x, LibintSigned *y);
 
+// Euclidean division, the remainder is never negative: 0 <= remainder < |y|.
+LibintError libint_div_euclid(Libint *libint, LibintSigned **out, LibintSigned *x, LibintSigned *y);
+
+LibintError libint_mod_euclid(Libint *libint, LibintSigned **out, LibintSigned *x, LibintSigned *y);
+
+LibintError libint_div_mod_euclid(
+        Libint *libint, LibintSigned **quotient, LibintSigned **remainder, LibintSigned *x, LibintSigned *y);
+
+// The *_into functions write into an existing number out, which may be x or y. Its memory is reused and grows only
+// when the result does not fit.
+LibintError libint_copy_into(Libint *libint, LibintSigned *out, LibintSigned *x);
+
+LibintError libint_add_into(Libint *libint, LibintSigned *out, LibintSigned *x, LibintSigned *y);
+
+LibintError libint_sub_into(Libint *libint, LibintSigned *out, LibintSigned *x, LibintSigned *y);
+
+LibintError libint_mul_into(Libint *libint, LibintSigned *out, LibintSigned *x, LibintSigned *y);
+
+LibintError libint_sqr_into(Libint *libint, LibintSigned *out, LibintSigned *x);
+
+LibintError libint_div_trunc_into(Libint *libint, LibintSigned *out, LibintSigned *x, LibintSigned *y);
+
+LibintError libint_mod_trunc_into(Libint *libint, LibintSigned *out, LibintSigned *x, LibintSigned *y);
+
+LibintError libint_div_floor_into(Libint *libint, LibintSigned *out, LibintSigned *x, LibintSigned *y);
+
+LibintError libint_mod_floor_into(Libint *libint, LibintSigned *out, LibintSigned *x, LibintSigned *y);
+
+LibintError libint_div_euclid_into(Libint *libint, LibintSigned *out, LibintSigned *x, LibintSigned *y);
+
+LibintError libint_mod_euclid_into(Libint *libint, LibintSigned *out, LibintSigned *x, LibintSigned *y);
+
 LibintError libint_add_replace(Libint *libint, LibintSigned **x, LibintSigned *y);
 
 LibintError libint_sub_replace(Libint *libint, LibintSigned **x, LibintSigned *y);
@@ -77,6 +193,26 @@ LibintError libint_less(Libint *libint, LibintSigned *x, LibintSigned *y, bool *
 
 LibintError libint_less_or_equal(Libint *libint, LibintSigned *x, LibintSigned *y, bool *out);
 
+// Operations with a machine integer y, which do not allocate a number for it.
+LibintError libint_add_si(Libint *libint, LibintSigned **out, LibintSigned *x, intmax_t y);
+
+LibintError libint_sub_si(Libint *libint, LibintSigned **out, LibintSigned *x, intmax_t y);
+
+LibintError libint_mul_si(Libint *libint, LibintSigned **out, LibintSigned *x, intmax_t y);
+
+LibintError libint_mul_ui(Libint *libint, LibintSigned **out, LibintSigned *x, uintmax_t y);
+
+// out = floor(x / y) and remainder = x - out * y, which is never negative. remainder may be NULL.
+LibintError libint_div_mod_ui(Libint *libint, LibintSigned **out, LibintSigned *x, uintmax_t y, uintmax_t *remainder);
+
+LibintError libint_add_si_replace(Libint *libint, LibintSigned **x, intmax_t y);
+
+LibintError libint_sub_si_replace(Libint *libint, LibintSigned **x, intmax_t y);
+
+LibintError libint_mul_si_replace(Libint *libint, LibintSigned **x, intmax_t y);
+
+LibintError libint_compare_si(Libint *libint, LibintSigned *x, intmax_t y, int *order);
+
 LibintError libint_unsigned_create(Libint *libint, LibintUnsigned **x, uintmax_t value);
 
 LibintError libint_unsigned_to_uintmax(Libint *libint, LibintUnsigned *x, uintmax_t *value);
@@ -86,6 +222,7 @@ LibintError libint_unsigned_from_string(
 
 LibintError libint_unsigned_to_string(Libint *libint, LibintUnsigned *x, int base, char **out, size_t *out_size);
 
+// Shares memory with x like libint_copy.
 LibintError libint_unsigned_copy(Libint *libint, LibintUnsigned **out, LibintUnsigned *x);
 
 LibintError libint_unsigned_destroy(Libint *libint, LibintUnsigned **x);
@@ -102,6 +239,8 @@ LibintError libint_unsigned_bitshift(Libint *libint, LibintUnsigned **out, Libin
 
 LibintError libint_unsigned_mul(Libint *libint, LibintUnsigned **out, LibintUnsigned *x, LibintUnsigned *y);
 
+LibintError libint_unsigned_sqr(Libint *libint, LibintUnsigned **out, LibintUnsigned *x);
+
 LibintError libint_unsigned_div(Libint *libint, LibintUnsigned **out, LibintUnsigned *x, LibintUnsigned *y);
 
 LibintError libint_unsigned_mod(Libint *libint, LibintUnsigned **out, LibintUnsigned *x, LibintUnsigned *y);
@@ -109,8 +248,26 @@ LibintError libint_unsigned_mod(Libint *libint, LibintUnsigned **out, LibintUnsi
 LibintError libint_unsigned_div_mod(
         Libint *libint, LibintUnsigned **out, LibintUnsigned **remainder, LibintUnsigned *x, LibintUnsigned *y);
 
+// out = x / y and remainder = x % y for a single word divisor y. remainder may be NULL.
+LibintError libint_unsigned_div_mod_word(
+        Libint *libint, LibintUnsigned **out, LibintUnsigned *x, LibintWord y, LibintWord *remainder);
+
 LibintError libint_unsigned_pow(Libint *libint, LibintUnsigned **out, LibintUnsigned *x, uintmax_t power);
 
+LibintError libint_unsigned_copy_into(Libint *libint, LibintUnsigned *out, LibintUnsigned *x);
+
+LibintError libint_unsigned_add_into(Libint *libint, LibintUnsigned *out, LibintUnsigned *x, LibintUnsigned *y);
+
+LibintError libint_unsigned_sub_into(Libint *libint, LibintUnsigned *out, LibintUnsigned *x, LibintUnsigned *y);
+
+LibintError libint_unsigned_mul_into(Libint *libint, LibintUnsigned *out, LibintUnsigned *x, LibintUnsigned *y);
+
+LibintError libint_unsigned_sqr_into(Libint *libint, LibintUnsigned *out, LibintUnsigned *x);
+
+LibintError libint_unsigned_div_into(Libint *libint, LibintUnsigned *out, LibintUnsigned *x, LibintUnsigned *y);
+
+LibintError libint_unsigned_mod_into(Libint *libint, LibintUnsigned *out, LibintUnsigned *x, LibintUnsigned *y);
+
 LibintError libint_unsigned_add_replace(Libint *libint, LibintUnsigned **x, LibintUnsigned *y);
 
 LibintError libint_unsigned_sub_replace(Libint *libint, LibintUnsigned **x, LibintUnsigned *y);
@@ -121,8 +278,17 @@ LibintError libint_unsigned_bitshift_replace(Libint *libint, LibintUnsigned **x,
 
 LibintError libint_unsigned_mul_replace(Libint *libint, LibintUnsigned **x, LibintUnsigned *y);
 
+// x = x * y for a single word y.
+LibintError libint_unsigned_mul_word_replace(Libint *libint, LibintUnsigned **x, LibintWord y);
+
+LibintError libint_unsigned_sqr_replace(Libint *libint, LibintUnsigned **x);
+
 LibintError libint_unsigned_div_replace(Libint *libint, LibintUnsigned **x, LibintUnsigned *y);
 
+// x = x / y and remainder = x % y for a single word y. remainder may be NULL.
+LibintError libint_unsigned_div_mod_word_replace(
+        Libint *libint, LibintUnsigned **x, LibintWord y, LibintWord *remainder);
+
 LibintError libint_unsigned_rdiv_replace(Libint *libint, LibintUnsigned **x, LibintUnsigned *y);
 
 LibintError libint_unsigned_pow_replace(Libint *libint, LibintUnsigned **x, uintmax_t power);
@@ -135,4 +301,99 @@ LibintError libint_unsigned_less(Libint *libint, LibintUnsigned *x, LibintUnsign
 
 LibintError libint_unsigned_less_or_equal(Libint *libint, LibintUnsigned *x, LibintUnsigned *y, bool *out);
 
+// Unsigned counterparts of the operations with a machine integer.
+LibintError libint_unsigned_add_ui(Libint *libint, LibintUnsigned **out, LibintUnsigned *x, uintmax_t y);
+
+LibintError libint_unsigned_sub_ui(Libint *libint, LibintUnsigned **out, LibintUnsigned *x, uintmax_t y);
+
+LibintError libint_unsigned_mul_ui(Libint *libint, LibintUnsigned **out, LibintUnsigned *x, uintmax_t y);
+
+// out = x / y and remainder = x % y. remainder may be NULL.
+LibintError libint_unsigned_div_mod_ui(
+        Libint *libint, LibintUnsigned **out, LibintUnsigned *x, uintmax_t y, uintmax_t *remainder);
+
+LibintError libint_unsigned_add_ui_replace(Libint *libint, LibintUnsigned **x, uintmax_t y);
+
+LibintError libint_unsigned_sub_ui_replace(Libint *libint, LibintUnsigned **x, uintmax_t y);
+
+LibintError libint_unsigned_mul_ui_replace(Libint *libint, LibintUnsigned **x, uintmax_t y);
+
+// x = x / y and remainder = x % y. remainder may be NULL.
+LibintError libint_unsigned_div_mod_ui_replace(Libint *libint, LibintUnsigned **x, uintmax_t y, uintmax_t *remainder);
+
+LibintError libint_unsigned_compare_ui(Libint *libint, LibintUnsigned *x, uintmax_t y, int *order);
+
+LibintError libint_divider_create(Libint *libint, LibintDivider **divider, LibintUnsigned *y);
+
+LibintError libint_divider_destroy(Libint *libint, LibintDivider **divider);
+
+LibintError libint_divider_div_mod(
+        Libint *libint, LibintUnsigned **out, LibintUnsigned **remainder, LibintUnsigned *x, LibintDivider *y);
+
+LibintError libint_divider_mod(Libint *libint, LibintUnsigned **out, LibintUnsigned *x, LibintDivider *y);
+
+// Numbers in the Montgomery form x * R mod modulus, where R = 2^(LIBINT_WORD_BITS * words of modulus), are multiplied
+// modulo the modulus without division. The modulus must be odd. Operands of libint_montgomery_from_form,
+// libint_montgomery_mul and libint_montgomery_sqr must be less than the modulus.
+LibintError libint_montgomery_create(Libint *libint, LibintMontgomery **montgomery, LibintUnsigned *modulus);
+
+LibintError libint_montgomery_destroy(Libint *libint, LibintMontgomery **montgomery);
+
+// out = x * R mod modulus.
+LibintError libint_montgomery_to_form(
+        Libint *libint, LibintUnsigned **out, LibintUnsigned *x, LibintMontgomery *montgomery);
+
+// out = x / R mod modulus.
+LibintError libint_montgomery_from_form(
+        Libint *libint, LibintUnsigned **out, LibintUnsigned *x, LibintMontgomery *montgomery);
+
+// out = x * y / R mod modulus, which is the Montgomery form of the product.
+LibintError libint_montgomery_mul(
+        Libint *libint, LibintUnsigned **out, LibintUnsigned *x, LibintUnsigned *y, LibintMontgomery *montgomery);
+
+LibintError libint_montgomery_sqr(
+        Libint *libint, LibintUnsigned **out, LibintUnsigned *x, LibintMontgomery *montgomery);
+
+// Arithmetic modulo any nonzero modulus, which replaces division by two multiplications by the precomputed
+// floor(B^(2 * k) / modulus), where B = 2^LIBINT_WORD_BITS and k is the number of words of the modulus. Operands of
+// libint_barrett_add, libint_barrett_sub, libint_barrett_mul and libint_barrett_pow must be less than the modulus.
+LibintError libint_barrett_create(Libint *libint, LibintBarrett **barrett, LibintUnsigned *modulus);
+
+LibintError libint_barrett_destroy(Libint *libint, LibintBarrett **barrett);
+
+// out = x mod modulus. Numbers less than B^(2 * k) are reduced without division.
+LibintError libint_barrett_mod(Libint *libint, LibintUnsigned **out, LibintUnsigned *x, LibintBarrett *barrett);
+
+LibintError libint_barrett_add(
+        Libint *libint, LibintUnsigned **out, LibintUnsigned *x, LibintUnsigned *y, LibintBarrett *barrett);
+
+LibintError libint_barrett_sub(
+        Libint *libint, LibintUnsigned **out, LibintUnsigned *x, LibintUnsigned *y, LibintBarrett *barrett);
+
+LibintError libint_barrett_mul(
+        Libint *libint, LibintUnsigned **out, LibintUnsigned *x, LibintUnsigned *y, LibintBarrett *barrett);
+
+// out = x^power mod modulus by sliding window exponentiation.
+LibintError libint_barrett_pow(
+        Libint *libint, LibintUnsigned **out, LibintUnsigned *x, LibintUnsigned *power, LibintBarrett *barrett);
+
+// out = x^power mod modulus by sliding window exponentiation. Uses Montgomery multiplication if the modulus is odd
+// and Barrett reduction otherwise.
+LibintError libint_unsigned_powmod(
+        Libint *libint, LibintUnsigned **out, LibintUnsigned *x, LibintUnsigned *power, LibintUnsigned *modulus);
+
+// The greatest common divisor, gcd(0, 0) = 0. Small numbers use the binary algorithm, bigger ones Lehmer's one and the
+// biggest ones half-GCD, which takes O(M(n) log n) time for multiplication time M(n).
+LibintError libint_unsigned_gcd(Libint *libint, LibintUnsigned **out, LibintUnsigned *x, LibintUnsigned *y);
+
+// out = gcd(x, y), which is not negative.
+LibintError libint_gcd(Libint *libint, LibintSigned **out, LibintSigned *x, LibintSigned *y);
+
+// out = gcd(x, y) = s * x + t * y. s and t may be NULL if they are not needed, t is found by division.
+LibintError libint_gcdext(
+        Libint *libint, LibintSigned **out, LibintSigned **s, LibintSigned **t, LibintSigned *x, LibintSigned *y);
+
+// out * x = 1 modulo the modulus and 0 <= out < |modulus|. Fails with LIBINT_ERROR_ARITHMETIC if there is no inverse.
+LibintError libint_invert(Libint *libint, LibintSigned **out, LibintSigned *x, LibintSigned *modulus);
+
 #endif
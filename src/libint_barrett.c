@@ -0,0 +1,256 @@
+#include "libint_internal.h"
+
+#include <assert.h>
+#include <string.h>
+
+size_t libint_words_barrett_scratch_size(Libint *libint, size_t size) {
+    // The product, the estimate of the quotient times the reciprocal, the quotient times the modulus and the scratch
+    // of the multiplications.
+    return 2 * size + (2 * size + 3) + (2 * size + 1) + libint_words_mul_scratch_size(libint, size + 2);
+}
+
+// The quotient t / modulus is estimated from the top words of t and the reciprocal, it is at most 2 less than the
+// true one (Menezes, van Oorschot, Vanstone "Handbook of Applied Cryptography", algorithm 14.42). Only the low
+// size + 1 words of the remainder are computed, the rest is known to be zero. Below the Toom-3 threshold the
+// half products that skip the unneeded words beat full Karatsuba products: the low words of the estimate, which only
+// lowers it by a few more units (note 14.44 there), and the high words of the quotient times the modulus.
+void libint_words_barrett_reduce(
+        Libint *libint, LibintWord *out, const LibintWord *t, const LibintBarrett *barrett, LibintWord *scratch) {
+    assert(libint && out && t && barrett && scratch);
+    size_t size = barrett->size;
+    const LibintWord *modulus = barrett->modulus->ptr;
+    const LibintWord *reciprocal = barrett->reciprocal->ptr;
+    size_t reciprocal_size = barrett->reciprocal->size;
+    assert(size + 1 <= reciprocal_size && reciprocal_size <= size + 2);
+    LibintWord *estimate = scratch;
+    LibintWord *remainder = estimate + 2 * size + 3;
+    LibintWord *mul_scratch = remainder + 2 * size + 1;
+    // floor(floor(t / B^(size - 1)) * reciprocal / B^(size + 1)), it has size + 1 words.
+    const LibintWord *high = t + size - 1;
+    const LibintWord *quotient = estimate + size + 1;
+    if (size < libint->mul_toom3_threshold) {
+        memset(estimate, 0, sizeof(LibintWord) * (size + 1));
+        for (size_t j = 0; j < reciprocal_size; ++j) {
+            size_t skipped = j + 1 < size ? size - 1 - j : 0;
+            estimate[j + size + 1] =
+                    libint_words_addmul_word(estimate + j + skipped, high + skipped, size + 1 - skipped, reciprocal[j]);
+        }
+        remainder[size] = libint_words_mul_word(remainder, modulus, size, quotient[0]);
+        for (size_t i = 1; i <= size; ++i) {
+            libint_words_addmul_word(remainder + i, modulus, size + 1 - i, quotient[i]);
+        }
+    } else {
+        libint_words_mul(libint, estimate, reciprocal, reciprocal_size, high, size + 1, mul_scratch);
+        libint_words_mul(libint, remainder, quotient, size + 1, modulus, size, mul_scratch);
+    }
+    libint_words_sub(remainder, t, size + 1, remainder, size + 1);
+    while (remainder[size] || libint_words_compare(remainder, modulus, size) >= 0) {
+        libint_words_sub(remainder, remainder, size + 1, modulus, size);
+    }
+    memcpy(out, remainder, sizeof(LibintWord) * size);
+}
+
+void libint_words_barrett_mul(Libint *libint, LibintWord *out, const LibintWord *x, const LibintWord *y,
+                              const LibintBarrett *barrett, LibintWord *scratch) {
+    assert(libint && out && x && y && barrett && scratch);
+    size_t size = barrett->size;
+    LibintWord *product = scratch + libint_words_barrett_scratch_size(libint, size) - 2 * size;
+    libint_words_mul(libint, product, x, size, y, size, scratch);
+    libint_words_barrett_reduce(libint, out, product, barrett, scratch);
+}
+
+void libint_words_barrett_sqr(
+        Libint *libint, LibintWord *out, const LibintWord *x, const LibintBarrett *barrett, LibintWord *scratch) {
+    assert(libint && out && x && barrett && scratch);
+    size_t size = barrett->size;
+    LibintWord *product = scratch + libint_words_barrett_scratch_size(libint, size) - 2 * size;
+    libint_words_sqr(libint, product, x, size, scratch);
+    libint_words_barrett_reduce(libint, out, product, barrett, scratch);
+}
+
+LibintError libint_barrett_create(Libint *libint, LibintBarrett **barrett, LibintUnsigned *modulus) {
+    LibintError err = LIBINT_ERROR_OK;
+    LibintBarrett *result = NULL;
+    if (!libint || !barrett || !modulus) {
+        err = LIBINT_ERROR_BAD_ARGUMENT;
+        goto end;
+    }
+    *barrett = NULL;
+    bool is_zero;
+    err = E(libint_unsigned_is_zero(libint, modulus, &is_zero));
+    if (err) goto end;
+    if (is_zero) {
+        err = LIBINT_ERROR_ARITHMETIC;
+        goto end;
+    }
+    result = libint_malloc(libint, sizeof(LibintBarrett));
+    if (!result) {
+        err = LIBINT_ERROR_OUT_OF_MEMORY;
+        goto end;
+    }
+    result->size = modulus->size;
+    result->modulus = NULL;
+    result->reciprocal = NULL;
+    err = E(libint_unsigned_copy(libint, &result->modulus, modulus));
+    if (err) goto end;
+    err = E(libint_unsigned_create(libint, &result->reciprocal, 1));
+    if (err) goto end;
+    err = E(libint_unsigned_bitshift_replace(libint, &result->reciprocal, (int) (2 * modulus->size * LIBINT_WORD_BITS)));
+    if (err) goto end;
+    err = E(libint_unsigned_div_into(libint, result->reciprocal, result->reciprocal, modulus));
+    if (err) goto end;
+    *barrett = result;
+    result = NULL;
+end:
+    E(libint_barrett_destroy(libint, &result));
+    return err;
+}
+
+LibintError libint_barrett_destroy(Libint *libint, LibintBarrett **barrett) {
+    LibintError err = LIBINT_ERROR_OK;
+    if (!libint || !barrett) {
+        err = LIBINT_ERROR_BAD_ARGUMENT;
+        goto end;
+    }
+    if (*barrett) {
+        E(libint_unsigned_destroy(libint, &(*barrett)->modulus));
+        E(libint_unsigned_destroy(libint, &(*barrett)->reciprocal));
+        libint_free(libint, *barrett);
+        *barrett = NULL;
+    }
+end:
+    return err;
+}
+
+typedef enum {
+    OPERATION_REDUCE,
+    OPERATION_MUL,
+    OPERATION_SQR,
+} Operation;
+
+// out = x mod modulus, x * y mod modulus or x^2 mod modulus. x has at most 2 * size words for OPERATION_REDUCE.
+static LibintError barrett_apply(Libint *libint, LibintUnsigned **out, LibintUnsigned *x, LibintUnsigned *y,
+                                 LibintBarrett *barrett, Operation operation) {
+    LibintError err = LIBINT_ERROR_OK;
+    LibintWord *result_ptr = NULL;
+    LibintWord *buffer = NULL;
+    size_t size = barrett->size;
+    err = E(libint_words_mul_prepare(libint, size + 2));
+    if (err) goto end;
+    result_ptr = libint_malloc(libint, sizeof(LibintWord) * size);
+    // The operands, which are padded, and the scratch.
+    buffer = libint_malloc(libint, sizeof(LibintWord) * (2 * size + libint_words_barrett_scratch_size(libint, size)));
+    if (!result_ptr || !buffer) {
+        err = LIBINT_ERROR_OUT_OF_MEMORY;
+        goto end;
+    }
+    LibintWord *operands = buffer;
+    LibintWord *scratch = buffer + 2 * size;
+    switch (operation) {
+    case OPERATION_REDUCE:
+        libint_unsigned_pad(operands, x, 2 * size);
+        libint_words_barrett_reduce(libint, result_ptr, operands, barrett, scratch);
+        break;
+    case OPERATION_MUL:
+        libint_unsigned_pad(operands, x, size);
+        libint_unsigned_pad(operands + size, y, size);
+        libint_words_barrett_mul(libint, result_ptr, operands, operands + size, barrett, scratch);
+        break;
+    case OPERATION_SQR:
+        libint_unsigned_pad(operands, x, size);
+        libint_words_barrett_sqr(libint, result_ptr, operands, barrett, scratch);
+        break;
+    }
+    err = E(libint_unsigned_construct(libint, out, libint_words_normalized_size(result_ptr, size), result_ptr));
+    if (err) goto end;
+    result_ptr = NULL;
+end:
+    libint_free(libint, result_ptr);
+    libint_free(libint, buffer);
+    return err;
+}
+
+LibintError libint_barrett_mod(Libint *libint, LibintUnsigned **out, LibintUnsigned *x, LibintBarrett *barrett) {
+    LibintError err = LIBINT_ERROR_OK;
+    if (!libint || !out || !x || !barrett) {
+        err = LIBINT_ERROR_BAD_ARGUMENT;
+        goto end;
+    }
+    *out = NULL;
+    if (x->size > 2 * barrett->size) {
+        err = E(libint_unsigned_mod(libint, out, x, barrett->modulus));
+        goto end;
+    }
+    err = E(barrett_apply(libint, out, x, NULL, barrett, OPERATION_REDUCE));
+    if (err) goto end;
+end:
+    return err;
+}
+
+LibintError libint_barrett_add(
+        Libint *libint, LibintUnsigned **out, LibintUnsigned *x, LibintUnsigned *y, LibintBarrett *barrett) {
+    LibintError err = LIBINT_ERROR_OK;
+    LibintUnsigned *result = NULL;
+    if (!libint || !out || !x || !y || !barrett || !libint_unsigned_is_reduced(x, barrett->modulus) ||
+        !libint_unsigned_is_reduced(y, barrett->modulus)) {
+        err = LIBINT_ERROR_BAD_ARGUMENT;
+        goto end;
+    }
+    *out = NULL;
+    err = E(libint_unsigned_add(libint, &result, x, y));
+    if (err) goto end;
+    if (!libint_unsigned_is_reduced(result, barrett->modulus)) {
+        err = E(libint_unsigned_sub_into(libint, result, result, barrett->modulus));
+        if (err) goto end;
+    }
+    *out = result;
+    result = NULL;
+end:
+    E(libint_unsigned_destroy(libint, &result));
+    return err;
+}
+
+LibintError libint_barrett_sub(
+        Libint *libint, LibintUnsigned **out, LibintUnsigned *x, LibintUnsigned *y, LibintBarrett *barrett) {
+    LibintError err = LIBINT_ERROR_OK;
+    LibintUnsigned *result = NULL;
+    if (!libint || !out || !x || !y || !barrett || !libint_unsigned_is_reduced(x, barrett->modulus) ||
+        !libint_unsigned_is_reduced(y, barrett->modulus)) {
+        err = LIBINT_ERROR_BAD_ARGUMENT;
+        goto end;
+    }
+    *out = NULL;
+    bool is_less;
+    err = E(libint_unsigned_less(libint, x, y, &is_less));
+    if (err) goto end;
+    if (is_less) {
+        // x - y + modulus, y - x is less than the modulus.
+        err = E(libint_unsigned_sub(libint, &result, y, x));
+        if (err) goto end;
+        err = E(libint_unsigned_sub_into(libint, result, barrett->modulus, result));
+        if (err) goto end;
+    } else {
+        err = E(libint_unsigned_sub(libint, &result, x, y));
+        if (err) goto end;
+    }
+    *out = result;
+    result = NULL;
+end:
+    E(libint_unsigned_destroy(libint, &result));
+    return err;
+}
+
+LibintError libint_barrett_mul(
+        Libint *libint, LibintUnsigned **out, LibintUnsigned *x, LibintUnsigned *y, LibintBarrett *barrett) {
+    LibintError err = LIBINT_ERROR_OK;
+    if (!libint || !out || !x || !y || !barrett || !libint_unsigned_is_reduced(x, barrett->modulus) ||
+        !libint_unsigned_is_reduced(y, barrett->modulus)) {
+        err = LIBINT_ERROR_BAD_ARGUMENT;
+        goto end;
+    }
+    *out = NULL;
+    err = E(barrett_apply(libint, out, x, y, barrett, x == y ? OPERATION_SQR : OPERATION_MUL));
+    if (err) goto end;
+end:
+    return err;
+}
@@ -0,0 +1,376 @@
+#include "libint_internal.h"
+
+#include <assert.h>
+#include <string.h>
+
+// Scratch of div_mod_recursive.
+static size_t recursive_scratch_size(Libint *libint, size_t q_size, size_t y_size) {
+    // Division by a given reciprocal starts at the threshold of dividers.
+    size_t newton_threshold = libint->div_newton_threshold < libint->divider_newton_threshold
+                                      ? libint->div_newton_threshold
+                                      : libint->divider_newton_threshold;
+    if (y_size >= newton_threshold && q_size >= newton_threshold) {
+        // Reciprocal of y, temporaries of the Newton iteration and their products.
+        return 5 * y_size + 5 + libint_words_mul_scratch_size(libint, y_size + 1);
+    }
+    if (y_size >= libint->div_burnikel_ziegler_threshold && q_size >= libint->div_burnikel_ziegler_threshold) {
+        // Product of a quotient block and the low part of the divisor.
+        return y_size + libint_words_mul_scratch_size(libint, y_size);
+    }
+    return 0;
+}
+
+size_t libint_words_div_mod_scratch_size(Libint *libint, size_t x_size, size_t y_size) {
+    assert(libint && x_size >= y_size);
+    // Normalized copy of y.
+    return y_size + libint_words_divider_div_mod_scratch_size(libint, x_size, y_size);
+}
+
+size_t libint_words_divider_div_mod_scratch_size(Libint *libint, size_t x_size, size_t y_size) {
+    assert(libint && x_size >= y_size);
+    // Normalized copy of x.
+    return x_size + 1 + recursive_scratch_size(libint, x_size + 1 - y_size, y_size);
+}
+
+size_t libint_words_reciprocal_newton_scratch_size(Libint *libint, size_t size) {
+    assert(libint);
+    return 4 * size + 4 + libint_words_mul_scratch_size(libint, size + 1);
+}
+
+LibintWord libint_words_reciprocal_3by2(LibintWord high, LibintWord low) {
+    assert(high >> (LIBINT_WORD_BITS - 1));
+    LibintWordReciprocal reciprocal;
+    libint_words_reciprocal(&reciprocal, high);
+    LibintWord v = reciprocal.reciprocal;
+    // Adjust the reciprocal of high for the low word, Moller, Granlund, algorithm 6.
+    LibintWord p = (LibintWord) (high * v + low);
+    if (p < low) {
+        --v;
+        if (p >= high) {
+            --v;
+            p -= high;
+        }
+        p -= high;
+    }
+    LibintDword t = (LibintDword) v * low;
+    LibintWord t1 = (LibintWord) (t >> LIBINT_WORD_BITS);
+    LibintWord t0 = (LibintWord) t;
+    p += t1;
+    if (p < t1) {
+        --v;
+        if (p > high || (p == high && t0 >= low)) {
+            --v;
+        }
+    }
+    return v;
+}
+
+// Divides u2:u1:u0 by the normalized d1:d0, where u2:u1 < d1:d0 and v is the reciprocal from
+// libint_words_reciprocal_3by2. Stores the remainder into r1:r0 and returns the quotient.
+static LibintWord div_3by2(LibintWord *r1, LibintWord *r0, LibintWord u2, LibintWord u1, LibintWord u0,
+                           LibintWord d1, LibintWord d0, LibintWord v) {
+    LibintDword q = (LibintDword) v * u2 + (((LibintDword) u2 << LIBINT_WORD_BITS) | u1);
+    LibintWord q1 = (LibintWord) (q >> LIBINT_WORD_BITS);
+    LibintWord q0 = (LibintWord) q;
+    // r = (u1 - q1 * d1):u0 - q1 * d0 - d1:d0 modulo B^2.
+    LibintWord high = (LibintWord) (u1 - q1 * d1);
+    LibintDword t = (LibintDword) d0 * q1;
+    LibintWord t1 = (LibintWord) (t >> LIBINT_WORD_BITS);
+    LibintWord t0 = (LibintWord) t;
+    LibintWord low = (LibintWord) (u0 - t0);
+    high = (LibintWord) (high - t1 - (u0 < t0));
+    high = (LibintWord) (high - d1 - (low < d0));
+    low = (LibintWord) (low - d0);
+    ++q1;
+    if (high >= q0) {
+        --q1;
+        low = (LibintWord) (low + d0);
+        high = (LibintWord) (high + d1 + (low < d0));
+    }
+    if (high > d1 || (high == d1 && low >= d0)) {
+        ++q1;
+        high = (LibintWord) (high - d1 - (low < d0));
+        low = (LibintWord) (low - d0);
+    }
+    *r1 = high;
+    *r0 = low;
+    return q1;
+}
+
+// out = x * y for operands in any order.
+static void mul(Libint *libint, LibintWord *out, const LibintWord *x, size_t x_size,
+                const LibintWord *y, size_t y_size, LibintWord *scratch) {
+    if (x_size >= y_size) {
+        libint_words_mul(libint, out, x, x_size, y, y_size, scratch);
+    } else {
+        libint_words_mul(libint, out, y, y_size, x, x_size, scratch);
+    }
+}
+
+// Knuth, The Art of Computer Programming, vol. 2, 4.3.1, Algorithm D. x is the normalized dividend of
+// x_size + 1 words, it is replaced by the remainder. y is the normalized divisor of y_size >= 2 words and v is
+// the reciprocal of its top two words. Every quotient word is found from the top three words of the partial
+// remainder without the hardware divide instruction, and is exact or one too big.
+static void div_mod_knuth(LibintWord *q, LibintWord *x, size_t x_size, const LibintWord *y, size_t y_size,
+                          LibintWord v) {
+    LibintWord y_hi = y[y_size - 1];
+    LibintWord y_lo = y[y_size - 2];
+    for (size_t j = x_size - y_size + 1; j--;) {
+        LibintWord *window = x + j;
+        LibintWord q_hat;
+        if (window[y_size] == y_hi && window[y_size - 1] == y_lo) {
+            // The quotient word does not fit the 3 by 2 division, but then it is B - 1.
+            q_hat = (LibintWord) -1;
+            LibintWord borrow = libint_words_submul_word(window, y, y_size, q_hat);
+            assert(window[y_size] == borrow);
+            (void) borrow;
+        } else {
+            LibintWord r1, r0;
+            q_hat = div_3by2(&r1, &r0, window[y_size], window[y_size - 1], window[y_size - 2], y_hi, y_lo, v);
+            LibintWord borrow = libint_words_submul_word(window, y, y_size - 2, q_hat);
+            LibintWord r0_borrow = r0 < borrow;
+            r0 -= borrow;
+            LibintWord r1_borrow = r1 < r0_borrow;
+            r1 -= r0_borrow;
+            window[y_size - 2] = r0;
+            window[y_size - 1] = r1;
+            if (r1_borrow) {
+                --q_hat;
+                libint_words_add(window, window, y_size, y, y_size);
+            }
+        }
+        window[y_size] = 0;
+        q[j] = q_hat;
+    }
+}
+
+static void div_mod_newton(Libint *libint, LibintWord *q, LibintWord *x, size_t q_size, const LibintWord *y,
+                           size_t y_size, LibintWord v, const LibintWord *reciprocal, LibintWord *scratch);
+
+// Burnikel, Ziegler "Fast Recursive Division" in the form of GMP's divide and conquer division. x has
+// y_size + q_size words and its top y_size words are less than the normalized divisor y. v is the reciprocal of
+// the top two words of y and reciprocal is NULL or the reciprocal of y from libint_words_reciprocal_newton.
+// q gets q_size words, the remainder replaces the low y_size words of x. Long enough blocks go to
+// div_mod_newton, from the threshold of dividers if the reciprocal is given. scratch must have room for
+// recursive_scratch_size(libint, q_size, y_size) words.
+static void div_mod_recursive(Libint *libint, LibintWord *q, LibintWord *x, size_t q_size, const LibintWord *y,
+                              size_t y_size, LibintWord v, const LibintWord *reciprocal, LibintWord *scratch) {
+    size_t threshold = libint->div_burnikel_ziegler_threshold;
+    if (q_size < threshold || y_size < threshold) {
+        div_mod_knuth(q, x, y_size + q_size - 1, y, y_size, v);
+        return;
+    }
+    size_t newton_threshold = reciprocal ? libint->divider_newton_threshold : libint->div_newton_threshold;
+    if (y_size >= newton_threshold && q_size >= y_size) {
+        div_mod_newton(libint, q, x, q_size, y, y_size, v, reciprocal, scratch);
+        return;
+    }
+    if (q_size > y_size) {
+        // Long division by blocks of y_size quotient words, the shortest block goes first.
+        size_t first_size = (q_size - 1) % y_size + 1;
+        size_t j = q_size - first_size;
+        div_mod_recursive(libint, q + j, x + j, first_size, y, y_size, v, reciprocal, scratch);
+        while (j) {
+            j -= y_size;
+            div_mod_recursive(libint, q + j, x + j, y_size, y, y_size, v, reciprocal, scratch);
+        }
+        return;
+    }
+    if (q_size == y_size) {
+        size_t low_size = q_size / 2;
+        size_t high_size = q_size - low_size;
+        div_mod_recursive(libint, q + low_size, x + low_size, high_size, y, y_size, v, reciprocal, scratch);
+        div_mod_recursive(libint, q, x, low_size, y, y_size, v, reciprocal, scratch);
+        return;
+    }
+    // Estimate the quotient by dividing the top 2 * q_size words of x by the top q_size words of y. The
+    // estimate is at most a few units too big. The top words of the reciprocal of y are a reciprocal of
+    // the top words of y a few units off, which is good enough for div_mod_reciprocal.
+    size_t low_size = y_size - q_size;
+    LibintWord *x_high = x + low_size;
+    const LibintWord *y_high = y + low_size;
+    const LibintWord *reciprocal_high = reciprocal ? reciprocal + low_size : NULL;
+    LibintWord q_carry = 0;
+    if (libint_words_compare(x_high + q_size, y_high, q_size) >= 0) {
+        libint_words_sub(x_high + q_size, x_high + q_size, q_size, y_high, q_size);
+        q_carry = 1;
+    }
+    div_mod_recursive(libint, q, x_high, q_size, y_high, q_size, v, reciprocal_high, scratch);
+    // Subtract the estimate times the low part of y from the partial remainder.
+    LibintWord *product = scratch;
+    mul(libint, product, q, q_size, y, low_size, scratch + y_size);
+    LibintWord borrow = libint_words_sub(x, x, y_size, product, y_size);
+    if (q_carry) {
+        borrow += libint_words_sub(x + q_size, x + q_size, low_size, y, low_size);
+    }
+    const LibintWord one = 1;
+    while (borrow) {
+        q_carry -= libint_words_sub(q, q, q_size, &one, 1);
+        borrow -= libint_words_add(x, x, y_size, y, y_size);
+    }
+    assert(!q_carry);
+}
+
+// Newton iteration for the reciprocal, v is the reciprocal of the top two words of y. Each step doubles the
+// precision of the reciprocal of the top half of y.
+static void reciprocal_newton(Libint *libint, LibintWord *out, const LibintWord *y, size_t size, LibintWord v,
+                              LibintWord *scratch) {
+    if (size < libint->div_newton_threshold) {
+        // Exact floor(B^(2 * size) / y).
+        LibintWord *x = scratch;
+        LibintWord *q = x + 2 * size + 1;
+        memset(x, 0, 2 * size * sizeof(LibintWord));
+        x[2 * size] = 1;
+        div_mod_recursive(libint, q, x, size + 1, y, size, v, NULL, q + size + 1);
+        memcpy(out, q, (size + 1) * sizeof(LibintWord));
+        return;
+    }
+    // The top high_size words of y give a reciprocal with one guard word more than half of the precision.
+    size_t high_size = size / 2 + 1;
+    size_t low_size = size - high_size;
+    LibintWord *r = out + low_size;
+    reciprocal_newton(libint, r, y + low_size, high_size, v, scratch);
+    memset(out, 0, low_size * sizeof(LibintWord));
+    // e = B^(size + high_size) - y * r is small, so only its low words and the sign matter. The top word of r is
+    // 1 or 2 and is multiplied separately, so that the product stays as short as the operands allow.
+    LibintWord *e = scratch;
+    size_t e_size = size + high_size;
+    mul(libint, e, y, size, r, high_size, e + e_size + 1);
+    e[e_size] = libint_words_addmul_word(e + high_size, y, size, r[high_size]);
+    bool is_negative = e[e_size];
+    assert(e[e_size] <= 1);
+    if (!is_negative) {
+        // Two's complement negation of the low e_size words.
+        for (size_t i = 0; i < e_size; ++i) {
+            e[i] = ~e[i];
+        }
+        const LibintWord one = 1;
+        libint_words_add(e, e, e_size, &one, 1);
+    }
+    // out = r * B^low_size +- r * e / B^(2 * high_size), the low high_size words of e are dropped.
+    LibintWord *e_high = e + high_size;
+    size_t e_high_size = libint_words_normalized_size(e_high, e_size - high_size);
+    LibintWord *product = e + e_size + 1;
+    mul(libint, product, r, high_size, e_high, e_high_size, product + high_size + 1 + e_high_size);
+    product[high_size + e_high_size] =
+            libint_words_addmul_word(product + high_size, e_high, e_high_size, r[high_size]);
+    LibintWord *correction = product + high_size;
+    size_t correction_size = libint_words_normalized_size(correction, e_high_size + 1);
+    if (correction_size > size + 1) {
+        correction_size = size + 1;
+    }
+    if (is_negative) {
+        LibintWord borrow = libint_words_sub(out, out, size + 1, correction, correction_size);
+        assert(!borrow);
+        (void) borrow;
+    } else {
+        LibintWord carry = libint_words_add(out, out, size + 1, correction, correction_size);
+        assert(!carry);
+        (void) carry;
+    }
+}
+
+void libint_words_reciprocal_newton(Libint *libint, LibintWord *out, const LibintWord *y, size_t size,
+                                    LibintWord *scratch) {
+    assert(libint && out && y && size >= 2 && y[size - 1] >> (LIBINT_WORD_BITS - 1));
+    reciprocal_newton(libint, out, y, size, libint_words_reciprocal_3by2(y[size - 1], y[size - 2]), scratch);
+}
+
+// x has 2 * size words and its top size words are less than the normalized divisor y. reciprocal is the
+// reciprocal of y up to a few units. q gets size words, the remainder replaces the low size words of x. scratch
+// must have room for 2 * size + 1 words and the scratch of libint_words_mul for size + 1 words.
+static void div_mod_reciprocal(Libint *libint, LibintWord *q, LibintWord *x, const LibintWord *y, size_t size,
+                               const LibintWord *reciprocal, LibintWord *scratch) {
+    // The top half of x times the reciprocal is a few units off the quotient. The top word of the reciprocal is
+    // multiplied separately, a product of size + 1 by size words may need a transform twice as long.
+    LibintWord *product = scratch;
+    libint_words_mul(libint, product, reciprocal, size, x + size, size, product + 2 * size + 1);
+    product[2 * size] = libint_words_addmul_word(product + size, x + size, size, reciprocal[size]);
+    if (product[2 * size]) {
+        memset(q, 0xFF, size * sizeof(LibintWord));
+    } else {
+        memcpy(q, product + size, size * sizeof(LibintWord));
+    }
+    libint_words_mul(libint, product, q, size, y, size, product + 2 * size);
+    LibintWord borrow = libint_words_sub(x, x, 2 * size, product, 2 * size);
+    const LibintWord one = 1;
+    while (borrow) {
+        LibintWord q_borrow = libint_words_sub(q, q, size, &one, 1);
+        assert(!q_borrow);
+        (void) q_borrow;
+        borrow -= libint_words_add(x, x, 2 * size, y, size);
+    }
+    while (libint_words_normalized_size(x + size, size) > 1 || x[size] || libint_words_compare(x, y, size) >= 0) {
+        LibintWord q_carry = libint_words_add(q, q, size, &one, 1);
+        assert(!q_carry);
+        (void) q_carry;
+        libint_words_sub(x, x, 2 * size, y, size);
+    }
+}
+
+// Division by blocks of y_size quotient words with one reciprocal of y, where q_size >= y_size. Arguments are as
+// of div_mod_recursive. The reciprocal is computed if it is NULL.
+static void div_mod_newton(Libint *libint, LibintWord *q, LibintWord *x, size_t q_size, const LibintWord *y,
+                           size_t y_size, LibintWord v, const LibintWord *reciprocal, LibintWord *scratch) {
+    if (!reciprocal) {
+        reciprocal_newton(libint, scratch, y, y_size, v, scratch + y_size + 1);
+        reciprocal = scratch;
+    }
+    scratch += y_size + 1;
+    size_t first_size = (q_size - 1) % y_size + 1;
+    size_t j = q_size - first_size;
+    if (first_size < y_size) {
+        div_mod_recursive(libint, q + j, x + j, first_size, y, y_size, v, reciprocal, scratch);
+    } else {
+        j += y_size;
+    }
+    while (j) {
+        j -= y_size;
+        div_mod_reciprocal(libint, q + j, x + j, y, y_size, reciprocal, scratch);
+    }
+}
+
+void libint_words_divider_div_mod(Libint *libint, LibintWord *q, LibintWord *r, const LibintWord *x, size_t x_size,
+                                  const LibintDivider *y, LibintWord *scratch) {
+    assert(libint && q && r && x && y && x_size >= y->size);
+    size_t y_size = y->size;
+    if (y_size == 1) {
+        r[0] = libint_words_div_word_reciprocal(q, x, x_size, &y->word_reciprocal);
+        return;
+    }
+    LibintWord *x_normalized = scratch;
+    if (y->shift) {
+        x_normalized[x_size] = libint_words_lshift(x_normalized, x, x_size, y->shift);
+    } else {
+        memcpy(x_normalized, x, x_size * sizeof(LibintWord));
+        x_normalized[x_size] = 0;
+    }
+    div_mod_recursive(libint, q, x_normalized, x_size + 1 - y_size, y->normalized, y_size, y->reciprocal,
+                      y->newton_reciprocal, x_normalized + x_size + 1);
+    if (y->shift) {
+        libint_words_rshift(r, x_normalized, y_size, y->shift);
+    } else {
+        memcpy(r, x_normalized, y_size * sizeof(LibintWord));
+    }
+}
+
+void libint_words_div_mod(Libint *libint, LibintWord *q, LibintWord *r, const LibintWord *x, size_t x_size,
+                          const LibintWord *y, size_t y_size, LibintWord *scratch) {
+    assert(libint && q && r && x && y && y_size && x_size >= y_size && y[y_size - 1]);
+    if (y_size == 1) {
+        r[0] = libint_words_div_word(q, x, x_size, y[0]);
+        return;
+    }
+    LibintDivider divider;
+    divider.size = y_size;
+    divider.shift = libint_words_leading_zeros(y[y_size - 1]);
+    divider.normalized = scratch;
+    if (divider.shift) {
+        libint_words_lshift(divider.normalized, y, y_size, divider.shift);
+    } else {
+        memcpy(divider.normalized, y, y_size * sizeof(LibintWord));
+    }
+    divider.reciprocal = libint_words_reciprocal_3by2(divider.normalized[y_size - 1], divider.normalized[y_size - 2]);
+    divider.newton_reciprocal = NULL;
+    libint_words_divider_div_mod(libint, q, r, x, x_size, &divider, scratch + y_size);
+}
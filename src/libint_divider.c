@@ -0,0 +1,183 @@
+#include "libint_internal.h"
+
+#include <string.h>
+
+LibintError libint_divider_create(Libint *libint, LibintDivider **divider, LibintUnsigned *y) {
+    LibintError err = LIBINT_ERROR_OK;
+    LibintDivider *result = NULL;
+    LibintWord *scratch = NULL;
+    if (!libint || !divider || !y) {
+        err = LIBINT_ERROR_BAD_ARGUMENT;
+        goto end;
+    }
+    *divider = NULL;
+    bool is_zero;
+    err = E(libint_unsigned_is_zero(libint, y, &is_zero));
+    if (err) goto end;
+    if (is_zero) {
+        err = LIBINT_ERROR_ARITHMETIC;
+        goto end;
+    }
+    result = libint_malloc(libint, sizeof(LibintDivider));
+    if (!result) {
+        err = LIBINT_ERROR_OUT_OF_MEMORY;
+        goto end;
+    }
+    result->size = y->size;
+    result->newton_reciprocal = NULL;
+    result->normalized = libint_malloc(libint, sizeof(LibintWord) * y->size);
+    if (!result->normalized) {
+        err = LIBINT_ERROR_OUT_OF_MEMORY;
+        goto end;
+    }
+    result->shift = libint_words_leading_zeros(y->ptr[y->size - 1]);
+    if (result->shift) {
+        libint_words_lshift(result->normalized, y->ptr, y->size, result->shift);
+    } else {
+        memcpy(result->normalized, y->ptr, sizeof(LibintWord) * y->size);
+    }
+    if (y->size == 1) {
+        libint_words_reciprocal(&result->word_reciprocal, y->ptr[0]);
+        result->reciprocal = 0;
+    } else {
+        result->reciprocal = libint_words_reciprocal_3by2(result->normalized[y->size - 1],
+                                                          result->normalized[y->size - 2]);
+    }
+    if (y->size >= libint->divider_newton_threshold) {
+        err = E(libint_words_mul_prepare(libint, y->size + 1));
+        if (err) goto end;
+        result->newton_reciprocal = libint_malloc(libint, sizeof(LibintWord) * (y->size + 1));
+        size_t scratch_size = libint_words_reciprocal_newton_scratch_size(libint, y->size);
+        scratch = libint_malloc(libint, sizeof(LibintWord) * scratch_size);
+        if (!result->newton_reciprocal || !scratch) {
+            err = LIBINT_ERROR_OUT_OF_MEMORY;
+            goto end;
+        }
+        libint_words_reciprocal_newton(libint, result->newton_reciprocal, result->normalized, y->size, scratch);
+    }
+    *divider = result;
+    result = NULL;
+end:
+    E(libint_divider_destroy(libint, &result));
+    libint_free(libint, scratch);
+    return err;
+}
+
+LibintError libint_divider_destroy(Libint *libint, LibintDivider **divider) {
+    LibintError err = LIBINT_ERROR_OK;
+    if (!libint || !divider) {
+        err = LIBINT_ERROR_BAD_ARGUMENT;
+        goto end;
+    }
+    if (*divider) {
+        libint_free(libint, (*divider)->normalized);
+        libint_free(libint, (*divider)->newton_reciprocal);
+        libint_free(libint, *divider);
+        *divider = NULL;
+    }
+end:
+    return err;
+}
+
+// Division by the divider, out may be NULL if only the remainder is needed.
+static LibintError divider_div_mod(
+        Libint *libint, LibintUnsigned **out, LibintUnsigned **remainder, LibintUnsigned *x, LibintDivider *y) {
+    LibintError err = LIBINT_ERROR_OK;
+    LibintUnsigned *quotient = NULL;
+    LibintWord *quotient_ptr = NULL;
+    LibintWord *remainder_ptr = NULL;
+    LibintWord *scratch = NULL;
+    if (x->size < y->size) {
+        if (out) {
+            err = E(libint_unsigned_create(libint, &quotient, 0));
+            if (err) goto end;
+        }
+        err = E(libint_unsigned_copy(libint, remainder, x));
+        if (err) goto end;
+        if (out) {
+            *out = quotient;
+            quotient = NULL;
+        }
+        goto end;
+    }
+    size_t quotient_size = x->size - y->size + 1;
+    size_t remainder_size = y->size;
+    size_t scratch_size = 0;
+    if (y->size > 1) {
+        err = E(libint_words_mul_prepare(libint, y->size + 1));
+        if (err) goto end;
+        scratch_size = libint_words_divider_div_mod_scratch_size(libint, x->size, y->size);
+    }
+    if (!out) {
+        // The quotient is not returned, so it is a part of the scratch.
+        scratch_size += quotient_size;
+    } else {
+        quotient_ptr = libint_malloc(libint, sizeof(LibintWord) * quotient_size);
+        if (!quotient_ptr) {
+            err = LIBINT_ERROR_OUT_OF_MEMORY;
+            goto end;
+        }
+    }
+    remainder_ptr = libint_malloc(libint, sizeof(LibintWord) * remainder_size);
+    if (!remainder_ptr) {
+        err = LIBINT_ERROR_OUT_OF_MEMORY;
+        goto end;
+    }
+    if (scratch_size) {
+        scratch = libint_malloc(libint, sizeof(LibintWord) * scratch_size);
+        if (!scratch) {
+            err = LIBINT_ERROR_OUT_OF_MEMORY;
+            goto end;
+        }
+    }
+    LibintWord *q = out ? quotient_ptr : scratch + scratch_size - quotient_size;
+    libint_words_divider_div_mod(libint, q, remainder_ptr, x->ptr, x->size, y, scratch);
+    if (out) {
+        quotient_size = libint_words_normalized_size(quotient_ptr, quotient_size);
+        err = E(libint_unsigned_construct(libint, &quotient, quotient_size, quotient_ptr));
+        if (err) goto end;
+        quotient_ptr = NULL;
+    }
+    remainder_size = libint_words_normalized_size(remainder_ptr, remainder_size);
+    err = E(libint_unsigned_construct(libint, remainder, remainder_size, remainder_ptr));
+    if (err) goto end;
+    remainder_ptr = NULL;
+    if (out) {
+        *out = quotient;
+        quotient = NULL;
+    }
+end:
+    E(libint_unsigned_destroy(libint, &quotient));
+    libint_free(libint, quotient_ptr);
+    libint_free(libint, remainder_ptr);
+    libint_free(libint, scratch);
+    return err;
+}
+
+LibintError libint_divider_div_mod(
+        Libint *libint, LibintUnsigned **out, LibintUnsigned **remainder, LibintUnsigned *x, LibintDivider *y) {
+    LibintError err = LIBINT_ERROR_OK;
+    if (!libint || !out || !remainder || !x || !y) {
+        err = LIBINT_ERROR_BAD_ARGUMENT;
+        goto end;
+    }
+    *out = NULL;
+    *remainder = NULL;
+    err = E(divider_div_mod(libint, out, remainder, x, y));
+    if (err) goto end;
+end:
+    return err;
+}
+
+LibintError libint_divider_mod(Libint *libint, LibintUnsigned **out, LibintUnsigned *x, LibintDivider *y) {
+    LibintError err = LIBINT_ERROR_OK;
+    if (!libint || !out || !x || !y) {
+        err = LIBINT_ERROR_BAD_ARGUMENT;
+        goto end;
+    }
+    *out = NULL;
+    err = E(divider_div_mod(libint, NULL, out, x, y));
+    if (err) goto end;
+end:
+    return err;
+}
@@ -0,0 +1,673 @@
+#include "libint_internal.h"
+
+#include <assert.h>
+#include <string.h>
+
+#ifdef LIBINT_64_BIT_WORDS
+__extension__ typedef __int128 SignedDword;
+#else
+typedef int64_t SignedDword;
+#endif
+
+// Reduction of a pair (a, b) to a pair (a', b') with the same greatest common divisor: (a, b) = M (a', b'), where the
+// entries of M are not negative and det M = -1 if is_odd, otherwise 1. Then a' = det M * (m11 * a - m01 * b), so
+// the second row holds the cofactors of a. The first row is NULL when only they are needed.
+typedef struct {
+    LibintUnsigned *m[2][2];
+    bool is_odd;
+} Matrix;
+
+// Matrix of a Lehmer step, its entries fit into words.
+typedef struct {
+    LibintWord m[2][2];
+    bool is_odd;
+} WordMatrix;
+
+static void matrix_destroy(Libint *libint, Matrix *matrix) {
+    for (int i = 0; i < 2; ++i) {
+        for (int j = 0; j < 2; ++j) {
+            E(libint_unsigned_destroy(libint, &matrix->m[i][j]));
+        }
+    }
+}
+
+// Makes matrix the identity, with the first row only if is_full.
+static LibintError matrix_create(Libint *libint, Matrix *matrix, bool is_full) {
+    LibintError err = LIBINT_ERROR_OK;
+    memset(matrix, 0, sizeof(Matrix));
+    for (int i = is_full ? 0 : 1; i < 2; ++i) {
+        for (int j = 0; j < 2; ++j) {
+            err = E(libint_unsigned_create(libint, &matrix->m[i][j], i == j));
+            if (err) goto end;
+        }
+    }
+end:
+    if (err) {
+        matrix_destroy(libint, matrix);
+    }
+    return err;
+}
+
+// out = x * x_factor + y * y_factor. out may be x, but not y.
+static LibintError add_products(Libint *libint, LibintUnsigned *out, LibintUnsigned *x, LibintWord x_factor,
+                                LibintUnsigned *y, LibintWord y_factor) {
+    LibintError err = LIBINT_ERROR_OK;
+    size_t x_size = x->size;
+    size_t y_size = y->size;
+    size_t size = (x_size > y_size ? x_size : y_size) + 2;
+    err = E(libint_unsigned_reserve(libint, out, size));
+    if (err) goto end;
+    LibintWord *r = out->ptr;
+    r[x_size] = libint_words_mul_word(r, x->ptr, x_size, x_factor);
+    memset(r + x_size + 1, 0, sizeof(LibintWord) * (size - x_size - 1));
+    LibintWord carry = libint_words_addmul_word(r, y->ptr, y_size, y_factor);
+    libint_words_add(r + y_size, r + y_size, size - y_size, &carry, 1);
+    out->size = libint_words_normalized_size(r, size);
+end:
+    return err;
+}
+
+// M = M N for a word matrix N.
+static LibintError matrix_mul_word(Libint *libint, Matrix *matrix, const WordMatrix *n) {
+    LibintError err = LIBINT_ERROR_OK;
+    LibintUnsigned *second = NULL;
+    err = E(libint_unsigned_allocate(libint, &second));
+    if (err) goto end;
+    for (int i = 0; i < 2; ++i) {
+        LibintUnsigned **row = matrix->m[i];
+        if (!row[0]) {
+            continue;
+        }
+        err = E(add_products(libint, second, row[0], n->m[0][1], row[1], n->m[1][1]));
+        if (err) goto end;
+        err = E(add_products(libint, row[0], row[0], n->m[0][0], row[1], n->m[1][0]));
+        if (err) goto end;
+        LibintUnsigned *t = row[1];
+        row[1] = second;
+        second = t;
+    }
+    matrix->is_odd ^= n->is_odd;
+end:
+    E(libint_unsigned_destroy(libint, &second));
+    return err;
+}
+
+// M = M [[q, 1], [1, 0]], the matrix of a division step with the quotient q.
+static LibintError matrix_mul_quotient(Libint *libint, Matrix *matrix, LibintUnsigned *q) {
+    LibintError err = LIBINT_ERROR_OK;
+    LibintUnsigned *first = NULL;
+    for (int i = 0; i < 2; ++i) {
+        LibintUnsigned **row = matrix->m[i];
+        if (!row[0]) {
+            continue;
+        }
+        err = E(libint_unsigned_mul(libint, &first, row[0], q));
+        if (err) goto end;
+        err = E(libint_unsigned_add_into(libint, first, first, row[1]));
+        if (err) goto end;
+        E(libint_unsigned_destroy(libint, &row[1]));
+        row[1] = row[0];
+        row[0] = first;
+        first = NULL;
+    }
+    matrix->is_odd = !matrix->is_odd;
+end:
+    E(libint_unsigned_destroy(libint, &first));
+    return err;
+}
+
+// M = M N.
+static LibintError matrix_mul(Libint *libint, Matrix *matrix, const Matrix *n) {
+    LibintError err = LIBINT_ERROR_OK;
+    LibintUnsigned *product = NULL;
+    LibintUnsigned *first = NULL;
+    LibintUnsigned *second = NULL;
+    for (int i = 0; i < 2; ++i) {
+        LibintUnsigned **row = matrix->m[i];
+        if (!row[0]) {
+            continue;
+        }
+        err = E(libint_unsigned_mul(libint, &first, row[0], n->m[0][0]));
+        if (err) goto end;
+        err = E(libint_unsigned_mul(libint, &product, row[1], n->m[1][0]));
+        if (err) goto end;
+        err = E(libint_unsigned_add_into(libint, first, first, product));
+        if (err) goto end;
+        E(libint_unsigned_destroy(libint, &product));
+        err = E(libint_unsigned_mul(libint, &second, row[0], n->m[0][1]));
+        if (err) goto end;
+        err = E(libint_unsigned_mul(libint, &product, row[1], n->m[1][1]));
+        if (err) goto end;
+        err = E(libint_unsigned_add_into(libint, second, second, product));
+        if (err) goto end;
+        E(libint_unsigned_destroy(libint, &product));
+        E(libint_unsigned_destroy(libint, &row[0]));
+        E(libint_unsigned_destroy(libint, &row[1]));
+        row[0] = first;
+        row[1] = second;
+        first = NULL;
+        second = NULL;
+    }
+    matrix->is_odd ^= n->is_odd;
+end:
+    E(libint_unsigned_destroy(libint, &product));
+    E(libint_unsigned_destroy(libint, &first));
+    E(libint_unsigned_destroy(libint, &second));
+    return err;
+}
+
+// Bits of x at the position of the leading word of a number of size words, shifted left by shift bits.
+static LibintWord leading_word(const LibintUnsigned *x, size_t size, unsigned shift) {
+    LibintWord high = size - 1 < x->size ? x->ptr[size - 1] : 0;
+    LibintWord low = size - 2 < x->size ? x->ptr[size - 2] : 0;
+    return shift ? high << shift | low >> (LIBINT_WORD_BITS - shift) : high;
+}
+
+// n / d for n >= 0 and d > 0. The quotients are mostly 1 and the numbers mostly fit into words, which saves a long
+// division.
+static SignedDword divide(SignedDword n, SignedDword d) {
+    if (n - d < d) {
+        return n >= d;
+    }
+    if (!((n | d) >> LIBINT_WORD_BITS)) {
+        return (LibintWord) n / (LibintWord) d;
+    }
+    return (SignedDword) ((LibintDword) n / (LibintDword) d);
+}
+
+// Finds the first quotients of the Euclidean algorithm for a >= b from their leading words by Lehmer's method
+// (Knuth "The Art of Computer Programming", volume 2, algorithm 4.5.2L): a quotient is taken only if it is the same for
+// the leading words rounded down and up. Single words are divided exactly. Returns false if no quotient is certain.
+static bool lehmer_matrix(WordMatrix *out, const LibintUnsigned *a, const LibintUnsigned *b) {
+    size_t size = a->size;
+    bool is_exact = size == 1;
+    SignedDword x, y;
+    if (is_exact) {
+        x = a->ptr[0];
+        y = b->ptr[0];
+    } else {
+        unsigned shift = libint_words_leading_zeros(a->ptr[size - 1]);
+        x = leading_word(a, size, shift);
+        y = leading_word(b, size, shift);
+    }
+    // (x, y) = (A x0 + B y0, C x0 + D y0) for the leading words x0 and y0 of a and b.
+    SignedDword A = 1, B = 0, C = 0, D = 1;
+    size_t steps = 0;
+    for (;;) {
+        SignedDword q;
+        if (is_exact) {
+            if (!y) {
+                break;
+            }
+            q = divide(x, y);
+        } else {
+            if (y + C == 0 || y + D == 0) {
+                break;
+            }
+            q = divide(x + A, y + C);
+            if (q != divide(x + B, y + D)) {
+                break;
+            }
+        }
+        SignedDword t = A - q * C;
+        A = C;
+        C = t;
+        t = B - q * D;
+        B = D;
+        D = t;
+        t = x - q * y;
+        x = y;
+        y = t;
+        ++steps;
+    }
+    if (!steps) {
+        return false;
+    }
+    // M is the inverse of [[A, B], [C, D]], whose determinant is (-1)^steps.
+    out->m[0][0] = (LibintWord) (D < 0 ? -D : D);
+    out->m[0][1] = (LibintWord) (B < 0 ? -B : B);
+    out->m[1][0] = (LibintWord) (C < 0 ? -C : C);
+    out->m[1][1] = (LibintWord) (A < 0 ? -A : A);
+    out->is_odd = steps % 2;
+    return true;
+}
+
+// out = x * x_factor - y * y_factor, which is known to fit into size words.
+static void sub_products(
+        LibintWord *out, const LibintWord *x, LibintWord x_factor, const LibintWord *y, LibintWord y_factor, size_t size) {
+    LibintWord high = libint_words_mul_word(out, x, size, x_factor);
+    high -= libint_words_submul_word(out, y, size, y_factor);
+    assert(!high);
+    (void) high;
+}
+
+// (a, b) = N^-1 (a, b) for the matrix of a Lehmer step, which is linear in the size of a.
+static LibintError lehmer_apply(Libint *libint, LibintUnsigned *a, LibintUnsigned *b, const WordMatrix *n) {
+    LibintError err = LIBINT_ERROR_OK;
+    size_t size = a->size;
+    LibintWord *scratch = libint_malloc(libint, sizeof(LibintWord) * 3 * size);
+    if (!scratch) {
+        err = LIBINT_ERROR_OUT_OF_MEMORY;
+        goto end;
+    }
+    LibintWord *a_result = scratch;
+    LibintWord *b_result = scratch + size;
+    LibintWord *b_padded = scratch + 2 * size;
+    memcpy(b_padded, b->ptr, sizeof(LibintWord) * b->size);
+    memset(b_padded + b->size, 0, sizeof(LibintWord) * (size - b->size));
+    if (!n->is_odd) {
+        sub_products(a_result, a->ptr, n->m[1][1], b_padded, n->m[0][1], size);
+        sub_products(b_result, b_padded, n->m[0][0], a->ptr, n->m[1][0], size);
+    } else {
+        sub_products(a_result, b_padded, n->m[0][1], a->ptr, n->m[1][1], size);
+        sub_products(b_result, a->ptr, n->m[1][0], b_padded, n->m[0][0], size);
+    }
+    err = E(libint_unsigned_reserve(libint, a, size));
+    if (err) goto end;
+    err = E(libint_unsigned_reserve(libint, b, size));
+    if (err) goto end;
+    memcpy(a->ptr, a_result, sizeof(LibintWord) * size);
+    a->size = libint_words_normalized_size(a->ptr, size);
+    memcpy(b->ptr, b_result, sizeof(LibintWord) * size);
+    b->size = libint_words_normalized_size(b->ptr, size);
+end:
+    libint_free(libint, scratch);
+    return err;
+}
+
+// (a, b) = N^-1 (a, b) if 0 <= b' < a' for the results. It holds when the quotients of N, which were found from the
+// leading words of a and b, are right for the whole numbers, and always means progress.
+static LibintError matrix_apply(
+        Libint *libint, LibintUnsigned **a, LibintUnsigned **b, const Matrix *n, bool *is_applied) {
+    LibintError err = LIBINT_ERROR_OK;
+    LibintUnsigned *products[4] = { NULL, NULL, NULL, NULL };
+    *is_applied = false;
+    // a' = det N * (n11 * a - n01 * b), b' = det N * (n00 * b - n10 * a).
+    err = E(libint_unsigned_mul(libint, &products[0], n->m[1][1], *a));
+    if (err) goto end;
+    err = E(libint_unsigned_mul(libint, &products[1], n->m[0][1], *b));
+    if (err) goto end;
+    err = E(libint_unsigned_mul(libint, &products[2], n->m[0][0], *b));
+    if (err) goto end;
+    err = E(libint_unsigned_mul(libint, &products[3], n->m[1][0], *a));
+    if (err) goto end;
+    if (n->is_odd) {
+        LibintUnsigned *t = products[0];
+        products[0] = products[1];
+        products[1] = t;
+        t = products[2];
+        products[2] = products[3];
+        products[3] = t;
+    }
+    bool is_less;
+    err = E(libint_unsigned_less(libint, products[0], products[1], &is_less));
+    if (err) goto end;
+    if (is_less) goto end;
+    err = E(libint_unsigned_less(libint, products[2], products[3], &is_less));
+    if (err) goto end;
+    if (is_less) goto end;
+    err = E(libint_unsigned_sub_into(libint, products[0], products[0], products[1]));
+    if (err) goto end;
+    err = E(libint_unsigned_sub_into(libint, products[2], products[2], products[3]));
+    if (err) goto end;
+    err = E(libint_unsigned_less(libint, products[2], products[0], &is_less));
+    if (err) goto end;
+    if (!is_less) goto end;
+    E(libint_unsigned_destroy(libint, a));
+    E(libint_unsigned_destroy(libint, b));
+    *a = products[0];
+    *b = products[2];
+    products[0] = NULL;
+    products[2] = NULL;
+    *is_applied = true;
+end:
+    for (int i = 0; i < 4; ++i) {
+        E(libint_unsigned_destroy(libint, &products[i]));
+    }
+    return err;
+}
+
+// (a, b) = (b, a mod b).
+static LibintError division_step(Libint *libint, LibintUnsigned **a, LibintUnsigned **b, Matrix *matrix) {
+    LibintError err = LIBINT_ERROR_OK;
+    LibintUnsigned *quotient = NULL;
+    LibintUnsigned *remainder = NULL;
+    err = E(libint_unsigned_div_mod(libint, &quotient, &remainder, *a, *b));
+    if (err) goto end;
+    if (matrix) {
+        err = E(matrix_mul_quotient(libint, matrix, quotient));
+        if (err) goto end;
+    }
+    E(libint_unsigned_destroy(libint, a));
+    *a = *b;
+    *b = remainder;
+    remainder = NULL;
+end:
+    E(libint_unsigned_destroy(libint, &quotient));
+    E(libint_unsigned_destroy(libint, &remainder));
+    return err;
+}
+
+static size_t trailing_zeros(const LibintUnsigned *x) {
+    size_t i = 0;
+    while (!x->ptr[i]) {
+        ++i;
+    }
+    return i * LIBINT_WORD_BITS + libint_words_trailing_zeros(x->ptr[i]);
+}
+
+// a = gcd(a, b) and b = 0 for nonzero a and b by Stein's binary algorithm, which only subtracts and shifts.
+static LibintError binary_gcd(Libint *libint, LibintUnsigned **a, LibintUnsigned **b) {
+    LibintError err = LIBINT_ERROR_OK;
+    if ((*a)->size == 1 && (*b)->size == 1) {
+        LibintWord x = (*a)->ptr[0];
+        LibintWord y = (*b)->ptr[0];
+        unsigned shift = libint_words_trailing_zeros(x | y);
+        x >>= libint_words_trailing_zeros(x);
+        do {
+            y >>= libint_words_trailing_zeros(y);
+            if (x > y) {
+                LibintWord t = x;
+                x = y;
+                y = t;
+            }
+            y -= x;
+        } while (y);
+        E(libint_unsigned_destroy(libint, a));
+        E(libint_unsigned_destroy(libint, b));
+        err = E(libint_unsigned_create(libint, a, x << shift));
+        if (err) goto end;
+        err = E(libint_unsigned_create(libint, b, 0));
+        if (err) goto end;
+        goto end;
+    }
+    size_t a_zeros = trailing_zeros(*a);
+    size_t b_zeros = trailing_zeros(*b);
+    err = E(libint_unsigned_bitshift_replace(libint, a, -(int) a_zeros));
+    if (err) goto end;
+    err = E(libint_unsigned_bitshift_replace(libint, b, -(int) b_zeros));
+    if (err) goto end;
+    for (;;) {
+        // Both are odd here.
+        bool is_less;
+        err = E(libint_unsigned_less(libint, *b, *a, &is_less));
+        if (err) goto end;
+        if (is_less) {
+            LibintUnsigned *t = *a;
+            *a = *b;
+            *b = t;
+        }
+        err = E(libint_unsigned_sub_into(libint, *b, *b, *a));
+        if (err) goto end;
+        bool is_zero;
+        err = E(libint_unsigned_is_zero(libint, *b, &is_zero));
+        if (err) goto end;
+        if (is_zero) {
+            break;
+        }
+        err = E(libint_unsigned_bitshift_replace(libint, b, -(int) trailing_zeros(*b)));
+        if (err) goto end;
+    }
+    err = E(libint_unsigned_bitshift_replace(libint, a, (int) (a_zeros < b_zeros ? a_zeros : b_zeros)));
+    if (err) goto end;
+end:
+    return err;
+}
+
+// Reduces a >= b until b has at most stop words or is zero, and accumulates the steps in matrix, which may be NULL.
+// Long pairs are reduced by half-GCD of their leading words (Thull, Yap "A unified approach to HGCD algorithms for
+// polynomials and integers"), which is this function again with a nonzero stop, short ones by Lehmer steps.
+static LibintError reduce(Libint *libint, LibintUnsigned **a, LibintUnsigned **b, Matrix *matrix, size_t stop) {
+    LibintError err = LIBINT_ERROR_OK;
+    LibintUnsigned *a_high = NULL;
+    LibintUnsigned *b_high = NULL;
+    Matrix n = { { { NULL, NULL }, { NULL, NULL } }, false };
+    for (;;) {
+        bool is_zero;
+        err = E(libint_unsigned_is_zero(libint, *b, &is_zero));
+        if (err) goto end;
+        if (is_zero || (*b)->size <= stop) {
+            break;
+        }
+        size_t size = (*a)->size;
+        if (!matrix && size < libint->gcd_lehmer_threshold) {
+            err = E(binary_gcd(libint, a, b));
+            goto end;
+        }
+        size_t threshold = stop ? libint->half_gcd_recursive_threshold : libint->gcd_half_gcd_threshold;
+        if (size >= threshold && (*b)->size + 1 >= size) {
+            // The leading m words reduced by half make a and b about m / 2 words shorter. At most half of the words
+            // are taken, so that the quotients found from them hold for a and b.
+            size_t m = 2 * (size - stop) < size / 2 ? 2 * (size - stop) : size / 2;
+            err = E(libint_unsigned_wordshift(libint, &a_high, *a, -(int) (size - m)));
+            if (err) goto end;
+            err = E(libint_unsigned_wordshift(libint, &b_high, *b, -(int) (size - m)));
+            if (err) goto end;
+            err = E(matrix_create(libint, &n, true));
+            if (err) goto end;
+            err = E(reduce(libint, &a_high, &b_high, &n, m / 2 + 1));
+            if (err) goto end;
+            E(libint_unsigned_destroy(libint, &a_high));
+            E(libint_unsigned_destroy(libint, &b_high));
+            bool is_applied = false;
+            err = E(libint_unsigned_is_zero(libint, n.m[0][1], &is_zero));
+            if (err) goto end;
+            if (n.is_odd || !is_zero) {
+                err = E(matrix_apply(libint, a, b, &n, &is_applied));
+                if (err) goto end;
+            }
+            if (is_applied && matrix) {
+                err = E(matrix_mul(libint, matrix, &n));
+                if (err) goto end;
+            }
+            matrix_destroy(libint, &n);
+            if (is_applied) {
+                continue;
+            }
+        }
+        WordMatrix w;
+        if ((*b)->size + 1 >= size && lehmer_matrix(&w, *a, *b)) {
+            err = E(lehmer_apply(libint, *a, *b, &w));
+            if (err) goto end;
+            if (matrix) {
+                err = E(matrix_mul_word(libint, matrix, &w));
+                if (err) goto end;
+            }
+        } else {
+            err = E(division_step(libint, a, b, matrix));
+            if (err) goto end;
+        }
+    }
+end:
+    E(libint_unsigned_destroy(libint, &a_high));
+    E(libint_unsigned_destroy(libint, &b_high));
+    matrix_destroy(libint, &n);
+    return err;
+}
+
+// a = gcd(a, b) and b = 0. If cofactor is not NULL, it gets s with gcd(a, b) = s * a + t * b for some t.
+static LibintError gcd(Libint *libint, LibintUnsigned **a, LibintUnsigned **b, LibintSigned **cofactor) {
+    LibintError err = LIBINT_ERROR_OK;
+    Matrix matrix = { { { NULL, NULL }, { NULL, NULL } }, false };
+    if (cofactor) {
+        err = E(matrix_create(libint, &matrix, false));
+        if (err) goto end;
+    }
+    bool is_less;
+    err = E(libint_unsigned_less(libint, *a, *b, &is_less));
+    if (err) goto end;
+    if (is_less) {
+        LibintUnsigned *t = *a;
+        *a = *b;
+        *b = t;
+        if (cofactor) {
+            // M = [[0, 1], [1, 0]].
+            t = matrix.m[1][0];
+            matrix.m[1][0] = matrix.m[1][1];
+            matrix.m[1][1] = t;
+            matrix.is_odd = true;
+        }
+    }
+    err = E(reduce(libint, a, b, cofactor ? &matrix : NULL, 0));
+    if (err) goto end;
+    if (cofactor) {
+        err = E(libint_construct(libint, cofactor, matrix.is_odd, matrix.m[1][1]));
+        if (err) goto end;
+        matrix.m[1][1] = NULL;
+    }
+end:
+    matrix_destroy(libint, &matrix);
+    return err;
+}
+
+LibintError libint_unsigned_gcd(Libint *libint, LibintUnsigned **out, LibintUnsigned *x, LibintUnsigned *y) {
+    LibintError err = LIBINT_ERROR_OK;
+    LibintUnsigned *a = NULL;
+    LibintUnsigned *b = NULL;
+    if (!libint || !out || !x || !y) {
+        err = LIBINT_ERROR_BAD_ARGUMENT;
+        goto end;
+    }
+    *out = NULL;
+    err = E(libint_unsigned_copy(libint, &a, x));
+    if (err) goto end;
+    err = E(libint_unsigned_copy(libint, &b, y));
+    if (err) goto end;
+    err = E(gcd(libint, &a, &b, NULL));
+    if (err) goto end;
+    *out = a;
+    a = NULL;
+end:
+    E(libint_unsigned_destroy(libint, &a));
+    E(libint_unsigned_destroy(libint, &b));
+    return err;
+}
+
+LibintError libint_gcd(Libint *libint, LibintSigned **out, LibintSigned *x, LibintSigned *y) {
+    LibintError err = LIBINT_ERROR_OK;
+    LibintUnsigned *result = NULL;
+    if (!libint || !out || !x || !y) {
+        err = LIBINT_ERROR_BAD_ARGUMENT;
+        goto end;
+    }
+    *out = NULL;
+    err = E(libint_unsigned_gcd(libint, &result, &x->magnitude, &y->magnitude));
+    if (err) goto end;
+    err = E(libint_construct(libint, out, false, result));
+    if (err) goto end;
+    result = NULL;
+end:
+    E(libint_unsigned_destroy(libint, &result));
+    return err;
+}
+
+LibintError libint_gcdext(
+        Libint *libint, LibintSigned **out, LibintSigned **s, LibintSigned **t, LibintSigned *x, LibintSigned *y) {
+    LibintError err = LIBINT_ERROR_OK;
+    LibintUnsigned *a = NULL;
+    LibintUnsigned *b = NULL;
+    LibintSigned *result = NULL;
+    LibintSigned *result_s = NULL;
+    LibintSigned *result_t = NULL;
+    if (!libint || !out || !x || !y) {
+        err = LIBINT_ERROR_BAD_ARGUMENT;
+        goto end;
+    }
+    *out = NULL;
+    if (s) {
+        *s = NULL;
+    }
+    if (t) {
+        *t = NULL;
+    }
+    err = E(libint_unsigned_copy(libint, &a, &x->magnitude));
+    if (err) goto end;
+    err = E(libint_unsigned_copy(libint, &b, &y->magnitude));
+    if (err) goto end;
+    err = E(gcd(libint, &a, &b, &result_s));
+    if (err) goto end;
+    err = E(libint_construct(libint, &result, false, a));
+    if (err) goto end;
+    a = NULL;
+    bool is_zero;
+    err = E(libint_unsigned_is_zero(libint, &result->magnitude, &is_zero));
+    if (err) goto end;
+    if (is_zero) {
+        // x = y = 0.
+        err = E(libint_mul_si_replace(libint, &result_s, 0));
+        if (err) goto end;
+    } else if (x->is_negative) {
+        // The cofactor was found for |x|.
+        err = E(libint_mul_si_replace(libint, &result_s, -1));
+        if (err) goto end;
+    }
+    if (t) {
+        // t = (gcd - s * x) / y, or 0 if y = 0.
+        err = E(libint_unsigned_is_zero(libint, &y->magnitude, &is_zero));
+        if (err) goto end;
+        if (is_zero) {
+            err = E(libint_create(libint, &result_t, 0));
+            if (err) goto end;
+        } else {
+            err = E(libint_mul(libint, &result_t, result_s, x));
+            if (err) goto end;
+            err = E(libint_rsub_replace(libint, &result_t, result));
+            if (err) goto end;
+            err = E(libint_div_trunc_into(libint, result_t, result_t, y));
+            if (err) goto end;
+        }
+    }
+    *out = result;
+    result = NULL;
+    if (s) {
+        *s = result_s;
+        result_s = NULL;
+    }
+    if (t) {
+        *t = result_t;
+        result_t = NULL;
+    }
+end:
+    E(libint_unsigned_destroy(libint, &a));
+    E(libint_unsigned_destroy(libint, &b));
+    E(libint_destroy(libint, &result));
+    E(libint_destroy(libint, &result_s));
+    E(libint_destroy(libint, &result_t));
+    return err;
+}
+
+LibintError libint_invert(Libint *libint, LibintSigned **out, LibintSigned *x, LibintSigned *modulus) {
+    LibintError err = LIBINT_ERROR_OK;
+    LibintSigned *reduced = NULL;
+    LibintUnsigned *a = NULL;
+    LibintUnsigned *b = NULL;
+    LibintSigned *cofactor = NULL;
+    if (!libint || !out || !x || !modulus) {
+        err = LIBINT_ERROR_BAD_ARGUMENT;
+        goto end;
+    }
+    *out = NULL;
+    err = E(libint_mod_euclid(libint, &reduced, x, modulus));
+    if (err) goto end;
+    err = E(libint_unsigned_copy(libint, &a, &reduced->magnitude));
+    if (err) goto end;
+    err = E(libint_unsigned_copy(libint, &b, &modulus->magnitude));
+    if (err) goto end;
+    err = E(gcd(libint, &a, &b, &cofactor));
+    if (err) goto end;
+    int order;
+    err = E(libint_unsigned_compare_ui(libint, a, 1, &order));
+    if (err) goto end;
+    if (order) {
+        err = LIBINT_ERROR_ARITHMETIC;
+        goto end;
+    }
+    err = E(libint_mod_euclid(libint, out, cofactor, modulus));
+    if (err) goto end;
+end:
+    E(libint_destroy(libint, &reduced));
+    E(libint_unsigned_destroy(libint, &a));
+    E(libint_unsigned_destroy(libint, &b));
+    E(libint_destroy(libint, &cofactor));
+    return err;
+}
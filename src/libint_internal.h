@@ -3,14 +3,17 @@
 
 #include <libint.h>
 
-#if 1
-typedef unsigned             LibintWord;
-typedef unsigned long long   LibintDword;
+#include <limits.h>
+#include <stdatomic.h>
+
+#ifdef LIBINT_64_BIT_WORDS
+__extension__ typedef unsigned __int128 LibintDword;
 #else
-typedef unsigned char        LibintWord;
-typedef unsigned short       LibintDword;
+typedef uint64_t LibintDword;
 #endif
 
+#define LIBINT_WORD_BITS (sizeof(LibintWord) * CHAR_BIT)
+
 _Static_assert((LibintWord) -1 > 0, "LibintWord must be unsigned");
 
 _Static_assert((LibintDword) -1 > 0, "LibintDword must be unsigned");
@@ -18,37 +21,338 @@ _Static_assert((LibintDword) -1 > 0, "LibintDword must be unsigned");
 _Static_assert(sizeof(LibintWord) * 2 <= sizeof(LibintDword),
                "LibintDword must be at least twice as big as LibintWord");
 
+_Static_assert(LIBINT_WORD_BITS == 32 || LIBINT_WORD_BITS == 64, "LibintWord must have 32 or 64 bits");
+
+typedef struct LibintArenaChunk_ LibintArenaChunk;
+
 struct Libint_ {
+    LibintAllocator allocator;
+    // Chunks of the arena, the most recent first, or NULL if numbers are not placed into an arena.
+    LibintArenaChunk *arena;
+    size_t arena_chunk_size;
+    // While nonzero, memory is taken from the allocator even if there is an arena. Used for caches that outlive the
+    // arena.
+    int arena_suspended;
     LibintSigned *libint_constants[17];
     LibintUnsigned *libint_unsigned_constants[17];
+    size_t mul_karatsuba_threshold;
+    size_t mul_toom3_threshold;
+    size_t mul_ntt_threshold;
+    size_t sqr_karatsuba_threshold;
+    size_t sqr_toom3_threshold;
+    size_t div_burnikel_ziegler_threshold;
+    size_t div_newton_threshold;
+    size_t divider_newton_threshold;
+    size_t to_string_recursive_threshold;
+    size_t from_string_recursive_threshold;
+    size_t gcd_lehmer_threshold;
+    size_t gcd_half_gcd_threshold;
+    size_t half_gcd_recursive_threshold;
+    // Powers of the roots of unity modulo the primes of number-theoretic transforms of up to ntt_table_size values and
+    // their quotients of Shoup. They are computed on demand by libint_words_mul_prepare.
+    uint32_t *ntt_tables[2];
+    size_t ntt_table_size;
+    // radix_powers[base][i] = (base^k)^(2^i), where base^k is the biggest power of base that fits into a word.
+    // They are computed on demand by libint_radix_power, radix_dividers[base][i] by libint_radix_divider.
+    LibintUnsigned **radix_powers[17];
+    LibintDivider **radix_dividers[17];
+    size_t radix_power_counts[17];
 };
 
+// Number of words stored in the number itself, so that small values need no separate buffer.
+#define LIBINT_INLINE_WORDS 2
+
+_Static_assert(sizeof(uintmax_t) <= sizeof(LibintWord) * LIBINT_INLINE_WORDS, "uintmax_t must fit into inline words");
+
 struct LibintUnsigned_ {
     size_t size;
+    // Number of words allocated at ptr, at least size. Replacing operations grow and shrink within it.
+    size_t capacity;
+    // Either inline_words or a buffer from libint_malloc.
     LibintWord *ptr;
+    // NULL or the number of numbers that share the buffer at ptr after libint_unsigned_share. The buffer is copied
+    // by libint_unsigned_reserve before it is modified.
+    _Atomic size_t *references;
+    // The number was created while no arena was in use, so its memory is taken from the allocator even inside one.
+    // Kept by libint_unsigned_release and libint_unsigned_move.
+    bool outside_arena;
+    LibintWord inline_words[LIBINT_INLINE_WORDS];
+};
+
+// Divisor prepared for division without the hardware divide instruction, see libint_words_reciprocal.
+typedef struct {
+    LibintWord divisor;
+    // divisor << shift, its most significant bit is set.
+    LibintWord normalized;
+    // floor((B^2 - 1) / normalized) - B, where B = 2^LIBINT_WORD_BITS.
+    LibintWord reciprocal;
+    unsigned shift;
+} LibintWordReciprocal;
+
+struct LibintDivider_ {
+    size_t size;
+    unsigned shift;
+    // Divisor shifted left by shift bits, so that its most significant bit is set.
+    LibintWord *normalized;
+    // Reciprocal of the divisor if it is a single word.
+    LibintWordReciprocal word_reciprocal;
+    // Reciprocal of the top two words of normalized, see libint_words_reciprocal_3by2.
+    LibintWord reciprocal;
+    // NULL or size + 1 words of the reciprocal from libint_words_reciprocal_newton.
+    LibintWord *newton_reciprocal;
+};
+
+struct LibintMontgomery_ {
+    size_t size;
+    // Shares the buffer with the number given to libint_montgomery_create.
+    LibintUnsigned *modulus;
+    // -modulus^-1 mod B, where B = 2^LIBINT_WORD_BITS.
+    LibintWord inverse;
+    // R^2 mod modulus, where R = B^size. Montgomery multiplication by it converts into the Montgomery form.
+    LibintUnsigned *r_squared;
+};
+
+struct LibintBarrett_ {
+    size_t size;
+    // Shares the buffer with the number given to libint_barrett_create.
+    LibintUnsigned *modulus;
+    // floor(B^(2 * size) / modulus), it has size + 1 or size + 2 words.
+    LibintUnsigned *reciprocal;
 };
 
 struct LibintSigned_ {
     bool is_negative;
-    LibintUnsigned *magnitude;
+    LibintUnsigned magnitude;
 };
 
 #define LIBINT_UNSIGNED_INVARIANT(x) \
-    ((x)->size == 1 || ((x)->size > 1 && (x)->ptr[(x)->size - 1]))
+    ((x)->size <= (x)->capacity && ((x)->size == 1 || ((x)->size > 1 && (x)->ptr[(x)->size - 1])))
 
 #define LIBINT_SIGNED_INVARIANT(x) \
-    (LIBINT_UNSIGNED_INVARIANT((x)->magnitude) && \
-     ((x)->magnitude->size > 1 || (x)->magnitude->ptr[0] || !(x)->is_negative))
+    (LIBINT_UNSIGNED_INVARIANT(&(x)->magnitude) && \
+     ((x)->magnitude.size > 1 || (x)->magnitude.ptr[0] || !(x)->is_negative))
 
 #define E libint_handle_internal_error
 
+// Allocation of the memory of numbers. It comes from the arena of libint if there is one, otherwise from its
+// allocator. libint_realloc and libint_free accept memory of both origins, and libint_realloc keeps a block where it
+// came from.
+void *libint_malloc(Libint *libint, size_t size);
+
+void *libint_realloc(Libint *libint, void *ptr, size_t size);
+
+void libint_free(Libint *libint, void *ptr);
+
+// Whether libint_malloc takes memory from the allocator.
+bool libint_outside_arena(Libint *libint);
+
 LibintError libint_handle_internal_error(LibintError err);
 
 LibintError libint_construct(Libint *libint, LibintSigned **x, bool is_negative, LibintUnsigned *magnitude);
 
 LibintError libint_unsigned_construct(Libint *libint, LibintUnsigned **x, size_t size, LibintWord *ptr);
 
+// Makes x a zero that keeps its words inline. Does not free the previous buffer.
+void libint_unsigned_init(LibintUnsigned *x);
+
+// Frees the buffer of x, if it is not inline, and makes x zero.
+void libint_unsigned_release(Libint *libint, LibintUnsigned *x);
+
+// Moves the value of from into to, which must be released. from becomes zero.
+void libint_unsigned_move(LibintUnsigned *to, LibintUnsigned *from);
+
+// Stores value into the inline words of x, so that x needs no release. Makes scalar operands without allocation.
+void libint_unsigned_set_uintmax(LibintUnsigned *x, uintmax_t value);
+
+// Whether x is less than modulus, that is an operand of modular arithmetic.
+bool libint_unsigned_is_reduced(const LibintUnsigned *x, const LibintUnsigned *modulus);
+
+// Copies x into size words, padding it with zeros.
+void libint_unsigned_pad(LibintWord *out, const LibintUnsigned *x, size_t size);
+
+// Allocates a zero, which takes a single allocation until it outgrows the inline words.
+LibintError libint_unsigned_allocate(Libint *libint, LibintUnsigned **x);
+
+// Makes out, which must be released, a copy of x that shares its buffer. Takes O(1) time.
+LibintError libint_unsigned_share(Libint *libint, LibintUnsigned *out, LibintUnsigned *x);
+
+// Makes room for at least capacity words in x, growing it geometrically. Keeps the value. Gives x its own buffer,
+// so every modification of x->ptr must be preceded by it.
+LibintError libint_unsigned_reserve(Libint *libint, LibintUnsigned *x, size_t capacity);
+
+// quotient = x / y and remainder = x % y, either may be NULL if it is not needed. The results are written into the
+// buffers quotient and remainder already have, they may be x or y.
+LibintError libint_unsigned_div_mod_into(
+        Libint *libint, LibintUnsigned *quotient, LibintUnsigned *remainder, LibintUnsigned *x, LibintUnsigned *y);
+
 LibintError libint_to_string_helper(
         Libint *libint, bool is_negative, LibintUnsigned *x, int base, char **out, size_t *out_size);
 
+// Returns the biggest power of base that fits into a word and stores its exponent into *exponent.
+LibintWord libint_radix_word(int base, size_t *exponent);
+
+// Stores the cached radix_powers[base][i] into *power, computing it if needed. It is owned by libint.
+LibintError libint_radix_power(Libint *libint, int base, size_t i, LibintUnsigned **power);
+
+// Stores the cached divider of radix_powers[base][i] into *divider, computing it if needed. It is owned by libint.
+LibintError libint_radix_divider(Libint *libint, int base, size_t i, LibintDivider **divider);
+
+// Frees the cached radix powers.
+void libint_radix_powers_destroy(Libint *libint);
+
+// Word-level kernels. They operate on raw little-endian arrays of words, never allocate and
+// cannot fail. Unless stated otherwise output may not overlap inputs.
+
+// Implementations of libint_words_add, libint_words_sub and the word multiplications. The fastest ones for the
+// processor are chosen once when the program is loaded, the portable ones are used instead if the environment variable
+// LIBINT_KERNELS is "portable".
+typedef struct {
+    LibintWord (*add)(LibintWord *out, const LibintWord *x, size_t x_size, const LibintWord *y, size_t y_size);
+    LibintWord (*sub)(LibintWord *out, const LibintWord *x, size_t x_size, const LibintWord *y, size_t y_size);
+    LibintWord (*mul_word)(LibintWord *out, const LibintWord *x, size_t size, LibintWord y);
+    LibintWord (*addmul_word)(LibintWord *out, const LibintWord *x, size_t size, LibintWord y);
+    LibintWord (*submul_word)(LibintWord *out, const LibintWord *x, size_t size, LibintWord y);
+} LibintWordKernels;
+
+// Kernels in plain C, which the ones for the processor must agree with.
+extern const LibintWordKernels libint_words_portable_kernels;
+
+// Returns size of x without leading zero words, but at least 1.
+size_t libint_words_normalized_size(const LibintWord *x, size_t size);
+
+// out = x + y, where x_size >= y_size and out has x_size words. Returns the carry word. out may be
+// equal to x or y.
+LibintWord libint_words_add(
+        LibintWord *out, const LibintWord *x, size_t x_size, const LibintWord *y, size_t y_size);
+
+// out = x - y, where x_size >= y_size and out has x_size words. Returns the borrow word. out may be
+// equal to x or y.
+LibintWord libint_words_sub(
+        LibintWord *out, const LibintWord *x, size_t x_size, const LibintWord *y, size_t y_size);
+
+// Compares two arrays of the same size. Returns -1, 0 or 1.
+int libint_words_compare(const LibintWord *x, const LibintWord *y, size_t size);
+
+// out = x << bits, where 0 < bits < LIBINT_WORD_BITS. Returns the bits shifted out. out may overlap x if out >= x.
+LibintWord libint_words_lshift(LibintWord *out, const LibintWord *x, size_t size, unsigned bits);
+
+// out = x >> bits, where 0 < bits < LIBINT_WORD_BITS. Returns the bits shifted out in the most
+// significant positions of the word. out may overlap x if out <= x.
+LibintWord libint_words_rshift(LibintWord *out, const LibintWord *x, size_t size, unsigned bits);
+
+// Returns the number of leading zero bits of nonzero x.
+unsigned libint_words_leading_zeros(LibintWord x);
+
+// Returns the number of trailing zero bits of nonzero x.
+unsigned libint_words_trailing_zeros(LibintWord x);
+
+// out = x / y. Returns the remainder. out may be equal to x.
+LibintWord libint_words_div_word(LibintWord *out, const LibintWord *x, size_t size, LibintWord y);
+
+// Prepares nonzero y for libint_words_div_word_reciprocal. Costs one hardware division.
+void libint_words_reciprocal(LibintWordReciprocal *out, LibintWord y);
+
+// out = x / y. Returns the remainder. out may be equal to x. Uses only multiplications
+// (Moller, Granlund "Improved division by invariant integers").
+LibintWord libint_words_div_word_reciprocal(
+        LibintWord *out, const LibintWord *x, size_t size, const LibintWordReciprocal *y);
+
+// out = x * y. Returns the carry word. out may be equal to x.
+LibintWord libint_words_mul_word(LibintWord *out, const LibintWord *x, size_t size, LibintWord y);
+
+// out += x * y, where out has size words. Returns the carry word.
+LibintWord libint_words_addmul_word(LibintWord *out, const LibintWord *x, size_t size, LibintWord y);
+
+// out -= x * y, where out has size words. Returns the borrow word.
+LibintWord libint_words_submul_word(LibintWord *out, const LibintWord *x, size_t size, LibintWord y);
+
+// out = x * y, out must have room for x_size + y_size words.
+void libint_words_mul_basecase(
+        LibintWord *out, const LibintWord *x, size_t x_size, const LibintWord *y, size_t y_size);
+
+// out = x^2, out must have room for 2 * size words.
+void libint_words_sqr_basecase(LibintWord *out, const LibintWord *x, size_t size);
+
+// Computes the tables libint_words_mul and libint_words_sqr need for operands of at most size words with the current
+// thresholds. Must be called before them, because they cannot fail.
+LibintError libint_words_mul_prepare(Libint *libint, size_t size);
+
+// Frees the tables of libint_words_mul_prepare.
+void libint_words_mul_tables_destroy(Libint *libint);
+
+// Number of scratch words libint_words_mul needs for operands of at most size words.
+size_t libint_words_mul_scratch_size(Libint *libint, size_t size);
+
+// out = x * y, where x_size >= y_size and out has room for x_size + y_size words. Chooses between
+// schoolbook, Karatsuba, Toom-3 and number-theoretic transform by the thresholds of libint. scratch must have room for
+// libint_words_mul_scratch_size(libint, x_size) words.
+void libint_words_mul(Libint *libint, LibintWord *out, const LibintWord *x, size_t x_size,
+                      const LibintWord *y, size_t y_size, LibintWord *scratch);
+
+// Number of scratch words libint_words_sqr needs for operands of at most size words.
+size_t libint_words_sqr_scratch_size(Libint *libint, size_t size);
+
+// out = x^2, where out has room for 2 * size words. Works like libint_words_mul, but computes every
+// cross product only once. scratch must have room for libint_words_sqr_scratch_size(libint, size) words.
+void libint_words_sqr(Libint *libint, LibintWord *out, const LibintWord *x, size_t size, LibintWord *scratch);
+
+// Number of scratch words libint_words_div_mod needs.
+size_t libint_words_div_mod_scratch_size(Libint *libint, size_t x_size, size_t y_size);
+
+// Returns floor((B^3 - 1) / (high * B + low)) - B, where B = 2^LIBINT_WORD_BITS and the most significant bit of
+// high is set.
+LibintWord libint_words_reciprocal_3by2(LibintWord high, LibintWord low);
+
+// Number of scratch words libint_words_reciprocal_newton needs.
+size_t libint_words_reciprocal_newton_scratch_size(Libint *libint, size_t size);
+
+// out = B^(2 * size) / y up to a few units, where y has size >= 2 words and its most significant bit is set.
+// out gets size + 1 words.
+void libint_words_reciprocal_newton(Libint *libint, LibintWord *out, const LibintWord *y, size_t size,
+                                    LibintWord *scratch);
+
+// Number of scratch words libint_words_divider_div_mod needs.
+size_t libint_words_divider_div_mod_scratch_size(Libint *libint, size_t x_size, size_t y_size);
+
+// Same as libint_words_div_mod with the normalization and reciprocals of y done beforehand.
+void libint_words_divider_div_mod(Libint *libint, LibintWord *q, LibintWord *r, const LibintWord *x, size_t x_size,
+                                  const LibintDivider *y, LibintWord *scratch);
+
+// q = x / y and r = x % y, where x_size >= y_size, the most significant word of y is not zero, q has room
+// for x_size - y_size + 1 words and r for y_size words. Chooses between schoolbook, Burnikel-Ziegler
+// and Newton reciprocal division by the thresholds of libint. scratch must have room for
+// libint_words_div_mod_scratch_size(libint, x_size, y_size) words, it is not used if y_size is 1.
+void libint_words_div_mod(Libint *libint, LibintWord *q, LibintWord *r, const LibintWord *x, size_t x_size,
+                          const LibintWord *y, size_t y_size, LibintWord *scratch);
+
+// Number of scratch words libint_words_montgomery_mul and libint_words_montgomery_sqr need.
+size_t libint_words_montgomery_scratch_size(Libint *libint, size_t size);
+
+// out = t / R mod modulus, where t has 2 * size words and is less than modulus * R. Overwrites t.
+void libint_words_montgomery_reduce(LibintWord *out, LibintWord *t, const LibintMontgomery *montgomery);
+
+// out = x * y / R mod modulus, where x and y have size words and are less than modulus. out may be equal to x or y.
+// scratch must have room for libint_words_montgomery_scratch_size(libint, size) words.
+void libint_words_montgomery_mul(Libint *libint, LibintWord *out, const LibintWord *x, const LibintWord *y,
+                                 const LibintMontgomery *montgomery, LibintWord *scratch);
+
+// out = x^2 / R mod modulus, like libint_words_montgomery_mul.
+void libint_words_montgomery_sqr(Libint *libint, LibintWord *out, const LibintWord *x,
+                                 const LibintMontgomery *montgomery, LibintWord *scratch);
+
+// Number of scratch words libint_words_barrett_reduce, libint_words_barrett_mul and libint_words_barrett_sqr need.
+size_t libint_words_barrett_scratch_size(Libint *libint, size_t size);
+
+// out = t mod modulus, where t has 2 * size words and is less than B^(2 * size).
+void libint_words_barrett_reduce(
+        Libint *libint, LibintWord *out, const LibintWord *t, const LibintBarrett *barrett, LibintWord *scratch);
+
+// out = x * y mod modulus, where x and y have size words and are less than modulus. out may be equal to x or y.
+void libint_words_barrett_mul(Libint *libint, LibintWord *out, const LibintWord *x, const LibintWord *y,
+                              const LibintBarrett *barrett, LibintWord *scratch);
+
+// out = x^2 mod modulus, like libint_words_barrett_mul.
+void libint_words_barrett_sqr(
+        Libint *libint, LibintWord *out, const LibintWord *x, const LibintBarrett *barrett, LibintWord *scratch);
+
 #endif
@@ -0,0 +1,213 @@
+#include "libint_internal.h"
+
+#include <stddef.h>
+#include <string.h>
+
+static void *system_allocate(void *state, size_t size) {
+    (void) state;
+    return malloc(size);
+}
+
+static void *system_reallocate(void *state, void *ptr, size_t size) {
+    (void) state;
+    return realloc(ptr, size);
+}
+
+static void system_deallocate(void *state, void *ptr) {
+    (void) state;
+    free(ptr);
+}
+
+const LibintAllocator libint_system_allocator = { system_allocate, system_reallocate, system_deallocate, NULL };
+
+// Every block is preceded by a header, so that it is known without a search where the block came from and an arena
+// block can be grown by copying.
+#define ARENA_ALIGNMENT (_Alignof(max_align_t))
+#define BLOCK_HEADER_SIZE ((sizeof(BlockHeader) + ARENA_ALIGNMENT - 1) / ARENA_ALIGNMENT * ARENA_ALIGNMENT)
+
+typedef struct {
+    // Chunk of the arena that holds the block, or NULL if the block was taken from the allocator.
+    LibintArenaChunk *chunk;
+    size_t size;
+} BlockHeader;
+
+struct LibintArenaChunk_ {
+    LibintArenaChunk *next;
+    // Bytes in data.
+    size_t size;
+    size_t used;
+    // Offset of the header of the last block, which can be grown or released in place.
+    size_t last;
+    max_align_t data[];
+};
+
+static size_t arena_block_size(size_t size) {
+    return BLOCK_HEADER_SIZE + (size + ARENA_ALIGNMENT - 1) / ARENA_ALIGNMENT * ARENA_ALIGNMENT;
+}
+
+static BlockHeader *block_header(void *ptr) {
+    return (BlockHeader *) ((char *) ptr - BLOCK_HEADER_SIZE);
+}
+
+static bool arena_is_last(LibintArenaChunk *chunk, void *ptr) {
+    return (char *) chunk->data + chunk->last + BLOCK_HEADER_SIZE == (char *) ptr;
+}
+
+static void *arena_allocate(Libint *libint, size_t size) {
+    if (size > SIZE_MAX - BLOCK_HEADER_SIZE - ARENA_ALIGNMENT) {
+        return NULL;
+    }
+    size_t block_size = arena_block_size(size);
+    LibintArenaChunk *chunk = libint->arena;
+    if (chunk->size - chunk->used < block_size) {
+        size_t chunk_size = block_size > libint->arena_chunk_size ? block_size : libint->arena_chunk_size;
+        chunk = libint->allocator.allocate(libint->allocator.state, sizeof(LibintArenaChunk) + chunk_size);
+        if (!chunk) {
+            return NULL;
+        }
+        chunk->next = libint->arena;
+        chunk->size = chunk_size;
+        chunk->used = 0;
+        chunk->last = 0;
+        libint->arena = chunk;
+    }
+    char *block = (char *) chunk->data + chunk->used;
+    BlockHeader *header = (BlockHeader *) block;
+    header->chunk = chunk;
+    header->size = size;
+    chunk->last = chunk->used;
+    chunk->used += block_size;
+    return block + BLOCK_HEADER_SIZE;
+}
+
+bool libint_outside_arena(Libint *libint) {
+    return !libint->arena || libint->arena_suspended;
+}
+
+void *libint_malloc(Libint *libint, size_t size) {
+    if (!libint_outside_arena(libint)) {
+        return arena_allocate(libint, size);
+    }
+    if (size > SIZE_MAX - BLOCK_HEADER_SIZE) {
+        return NULL;
+    }
+    BlockHeader *header = libint->allocator.allocate(libint->allocator.state, BLOCK_HEADER_SIZE + size);
+    if (!header) {
+        return NULL;
+    }
+    header->chunk = NULL;
+    header->size = size;
+    return (char *) header + BLOCK_HEADER_SIZE;
+}
+
+void *libint_realloc(Libint *libint, void *ptr, size_t size) {
+    if (!ptr) {
+        return libint_malloc(libint, size);
+    }
+    BlockHeader *header = block_header(ptr);
+    LibintArenaChunk *chunk = header->chunk;
+    if (!chunk) {
+        // Blocks allocated outside of the arena stay outside.
+        if (size > SIZE_MAX - BLOCK_HEADER_SIZE) {
+            return NULL;
+        }
+        header = libint->allocator.reallocate(libint->allocator.state, header, BLOCK_HEADER_SIZE + size);
+        if (!header) {
+            return NULL;
+        }
+        header->size = size;
+        return (char *) header + BLOCK_HEADER_SIZE;
+    }
+    if (size <= SIZE_MAX - BLOCK_HEADER_SIZE - ARENA_ALIGNMENT && arena_is_last(chunk, ptr) &&
+            chunk->last + arena_block_size(size) <= chunk->size) {
+        header->size = size;
+        chunk->used = chunk->last + arena_block_size(size);
+        return ptr;
+    }
+    void *result = arena_allocate(libint, size);
+    if (!result) {
+        return NULL;
+    }
+    memcpy(result, ptr, header->size < size ? header->size : size);
+    return result;
+}
+
+void libint_free(Libint *libint, void *ptr) {
+    if (!ptr) {
+        return;
+    }
+    BlockHeader *header = block_header(ptr);
+    LibintArenaChunk *chunk = header->chunk;
+    if (!chunk) {
+        libint->allocator.deallocate(libint->allocator.state, header);
+        return;
+    }
+    // Other blocks of the arena are only released by libint_arena_reset.
+    if (arena_is_last(chunk, ptr)) {
+        chunk->used = chunk->last;
+    }
+}
+
+LibintError libint_arena_begin(Libint *libint, size_t chunk_size) {
+    LibintError err = LIBINT_ERROR_OK;
+    if (!libint || !chunk_size || libint->arena) {
+        err = LIBINT_ERROR_BAD_ARGUMENT;
+        goto end;
+    }
+    LibintArenaChunk *chunk =
+            libint->allocator.allocate(libint->allocator.state, sizeof(LibintArenaChunk) + chunk_size);
+    if (!chunk) {
+        err = LIBINT_ERROR_OUT_OF_MEMORY;
+        goto end;
+    }
+    chunk->next = NULL;
+    chunk->size = chunk_size;
+    chunk->used = 0;
+    chunk->last = 0;
+    libint->arena = chunk;
+    libint->arena_chunk_size = chunk_size;
+end:
+    return err;
+}
+
+LibintError libint_arena_reset(Libint *libint) {
+    LibintError err = LIBINT_ERROR_OK;
+    if (!libint || !libint->arena) {
+        err = LIBINT_ERROR_BAD_ARGUMENT;
+        goto end;
+    }
+    // The biggest chunk is kept for the next computation.
+    LibintArenaChunk *kept = libint->arena;
+    for (LibintArenaChunk *chunk = libint->arena->next; chunk; chunk = chunk->next) {
+        if (chunk->size > kept->size) {
+            kept = chunk;
+        }
+    }
+    LibintArenaChunk *chunk = libint->arena;
+    while (chunk) {
+        LibintArenaChunk *next = chunk->next;
+        if (chunk != kept) {
+            libint->allocator.deallocate(libint->allocator.state, chunk);
+        }
+        chunk = next;
+    }
+    kept->next = NULL;
+    kept->used = 0;
+    kept->last = 0;
+    libint->arena = kept;
+end:
+    return err;
+}
+
+LibintError libint_arena_end(Libint *libint) {
+    LibintError err = LIBINT_ERROR_OK;
+    if (!libint || !libint->arena) {
+        err = LIBINT_ERROR_BAD_ARGUMENT;
+        goto end;
+    }
+    E(libint_arena_reset(libint));
+    libint->allocator.deallocate(libint->allocator.state, libint->arena);
+    libint->arena = NULL;
+end:
+    return err;
+}
@@ -0,0 +1,211 @@
+#include "libint_internal.h"
+
+#include <assert.h>
+#include <string.h>
+
+size_t libint_words_montgomery_scratch_size(Libint *libint, size_t size) {
+    size_t mul_scratch_size = libint_words_mul_scratch_size(libint, size);
+    size_t sqr_scratch_size = libint_words_sqr_scratch_size(libint, size);
+    return 2 * size + (mul_scratch_size > sqr_scratch_size ? mul_scratch_size : sqr_scratch_size);
+}
+
+// Adds the multiple of the modulus that clears the low word of t, one word at a time (Montgomery REDC). The carry out
+// of the top of every step is added at the next step, so it never runs through the rest of t.
+void libint_words_montgomery_reduce(LibintWord *out, LibintWord *t, const LibintMontgomery *montgomery) {
+    assert(out && t && montgomery);
+    size_t size = montgomery->size;
+    const LibintWord *modulus = montgomery->modulus->ptr;
+    LibintWord carry = 0;
+    for (size_t i = 0; i < size; ++i) {
+        LibintWord u = t[i] * montgomery->inverse;
+        LibintWord c = libint_words_addmul_word(t + i, modulus, size, u);
+        LibintWord sum = t[i + size] + carry;
+        carry = sum < carry;
+        sum += c;
+        carry += sum < c;
+        t[i + size] = sum;
+    }
+    // The result is less than 2 * modulus.
+    if (carry || libint_words_compare(t + size, modulus, size) >= 0) {
+        libint_words_sub(out, t + size, size, modulus, size);
+    } else {
+        memmove(out, t + size, sizeof(LibintWord) * size);
+    }
+}
+
+void libint_words_montgomery_mul(Libint *libint, LibintWord *out, const LibintWord *x, const LibintWord *y,
+                                 const LibintMontgomery *montgomery, LibintWord *scratch) {
+    assert(libint && out && x && y && montgomery && scratch);
+    size_t size = montgomery->size;
+    libint_words_mul(libint, scratch, x, size, y, size, scratch + 2 * size);
+    libint_words_montgomery_reduce(out, scratch, montgomery);
+}
+
+void libint_words_montgomery_sqr(Libint *libint, LibintWord *out, const LibintWord *x,
+                                 const LibintMontgomery *montgomery, LibintWord *scratch) {
+    assert(libint && out && x && montgomery && scratch);
+    size_t size = montgomery->size;
+    libint_words_sqr(libint, scratch, x, size, scratch + 2 * size);
+    libint_words_montgomery_reduce(out, scratch, montgomery);
+}
+
+// Returns x^-1 mod B for odd x by Newton iteration. x is its own inverse modulo 8, and every step doubles the number
+// of correct bits.
+static LibintWord inverse_word(LibintWord x) {
+    LibintWord inverse = x;
+    for (int i = 0; i < 5; ++i) {
+        inverse *= 2 - x * inverse;
+    }
+    assert(x * inverse == 1);
+    return inverse;
+}
+
+LibintError libint_montgomery_create(Libint *libint, LibintMontgomery **montgomery, LibintUnsigned *modulus) {
+    LibintError err = LIBINT_ERROR_OK;
+    LibintMontgomery *result = NULL;
+    if (!libint || !montgomery || !modulus) {
+        err = LIBINT_ERROR_BAD_ARGUMENT;
+        goto end;
+    }
+    *montgomery = NULL;
+    if (!(modulus->ptr[0] & 1)) {
+        err = LIBINT_ERROR_ARITHMETIC;
+        goto end;
+    }
+    result = libint_malloc(libint, sizeof(LibintMontgomery));
+    if (!result) {
+        err = LIBINT_ERROR_OUT_OF_MEMORY;
+        goto end;
+    }
+    result->size = modulus->size;
+    result->modulus = NULL;
+    result->inverse = 0 - inverse_word(modulus->ptr[0]);
+    result->r_squared = NULL;
+    err = E(libint_unsigned_copy(libint, &result->modulus, modulus));
+    if (err) goto end;
+    err = E(libint_unsigned_create(libint, &result->r_squared, 1));
+    if (err) goto end;
+    err = E(libint_unsigned_bitshift_replace(libint, &result->r_squared, (int) (2 * modulus->size * LIBINT_WORD_BITS)));
+    if (err) goto end;
+    err = E(libint_unsigned_mod_into(libint, result->r_squared, result->r_squared, modulus));
+    if (err) goto end;
+    *montgomery = result;
+    result = NULL;
+end:
+    E(libint_montgomery_destroy(libint, &result));
+    return err;
+}
+
+LibintError libint_montgomery_destroy(Libint *libint, LibintMontgomery **montgomery) {
+    LibintError err = LIBINT_ERROR_OK;
+    if (!libint || !montgomery) {
+        err = LIBINT_ERROR_BAD_ARGUMENT;
+        goto end;
+    }
+    if (*montgomery) {
+        E(libint_unsigned_destroy(libint, &(*montgomery)->modulus));
+        E(libint_unsigned_destroy(libint, &(*montgomery)->r_squared));
+        libint_free(libint, *montgomery);
+        *montgomery = NULL;
+    }
+end:
+    return err;
+}
+
+// out = x * y / R mod modulus, or x^2 / R mod modulus if y is NULL. Both operands must be less than the modulus.
+static LibintError montgomery_mul(
+        Libint *libint, LibintUnsigned **out, LibintUnsigned *x, LibintUnsigned *y, LibintMontgomery *montgomery) {
+    LibintError err = LIBINT_ERROR_OK;
+    LibintWord *result_ptr = NULL;
+    LibintWord *scratch = NULL;
+    size_t size = montgomery->size;
+    err = E(libint_words_mul_prepare(libint, size));
+    if (err) goto end;
+    result_ptr = libint_malloc(libint, sizeof(LibintWord) * size);
+    // Room for both operands, which are padded to the size of the modulus.
+    scratch = libint_malloc(libint, sizeof(LibintWord) * (2 * size + libint_words_montgomery_scratch_size(libint, size)));
+    if (!result_ptr || !scratch) {
+        err = LIBINT_ERROR_OUT_OF_MEMORY;
+        goto end;
+    }
+    LibintWord *x_words = scratch;
+    LibintWord *y_words = scratch + size;
+    libint_unsigned_pad(x_words, x, size);
+    if (y) {
+        libint_unsigned_pad(y_words, y, size);
+        libint_words_montgomery_mul(libint, result_ptr, x_words, y_words, montgomery, scratch + 2 * size);
+    } else {
+        libint_words_montgomery_sqr(libint, result_ptr, x_words, montgomery, scratch + 2 * size);
+    }
+    err = E(libint_unsigned_construct(libint, out, libint_words_normalized_size(result_ptr, size), result_ptr));
+    if (err) goto end;
+    result_ptr = NULL;
+end:
+    libint_free(libint, result_ptr);
+    libint_free(libint, scratch);
+    return err;
+}
+
+LibintError libint_montgomery_to_form(
+        Libint *libint, LibintUnsigned **out, LibintUnsigned *x, LibintMontgomery *montgomery) {
+    LibintError err = LIBINT_ERROR_OK;
+    LibintUnsigned *reduced = NULL;
+    if (!libint || !out || !x || !montgomery) {
+        err = LIBINT_ERROR_BAD_ARGUMENT;
+        goto end;
+    }
+    *out = NULL;
+    err = E(libint_unsigned_mod(libint, &reduced, x, montgomery->modulus));
+    if (err) goto end;
+    err = E(montgomery_mul(libint, out, reduced, montgomery->r_squared, montgomery));
+    if (err) goto end;
+end:
+    E(libint_unsigned_destroy(libint, &reduced));
+    return err;
+}
+
+LibintError libint_montgomery_from_form(
+        Libint *libint, LibintUnsigned **out, LibintUnsigned *x, LibintMontgomery *montgomery) {
+    LibintError err = LIBINT_ERROR_OK;
+    if (!libint || !out || !x || !montgomery || !libint_unsigned_is_reduced(x, montgomery->modulus)) {
+        err = LIBINT_ERROR_BAD_ARGUMENT;
+        goto end;
+    }
+    *out = NULL;
+    // Montgomery multiplication by 1 divides by R. Modulo 1 every number is 0, which has to be used instead.
+    LibintUnsigned one;
+    libint_unsigned_set_uintmax(&one, montgomery->size > 1 || montgomery->modulus->ptr[0] > 1);
+    err = E(montgomery_mul(libint, out, x, &one, montgomery));
+    if (err) goto end;
+end:
+    return err;
+}
+
+LibintError libint_montgomery_mul(
+        Libint *libint, LibintUnsigned **out, LibintUnsigned *x, LibintUnsigned *y, LibintMontgomery *montgomery) {
+    LibintError err = LIBINT_ERROR_OK;
+    if (!libint || !out || !x || !y || !montgomery || !libint_unsigned_is_reduced(x, montgomery->modulus) ||
+        !libint_unsigned_is_reduced(y, montgomery->modulus)) {
+        err = LIBINT_ERROR_BAD_ARGUMENT;
+        goto end;
+    }
+    *out = NULL;
+    err = E(montgomery_mul(libint, out, x, x == y ? NULL : y, montgomery));
+    if (err) goto end;
+end:
+    return err;
+}
+
+LibintError libint_montgomery_sqr(
+        Libint *libint, LibintUnsigned **out, LibintUnsigned *x, LibintMontgomery *montgomery) {
+    LibintError err = LIBINT_ERROR_OK;
+    if (!libint || !out || !x || !montgomery || !libint_unsigned_is_reduced(x, montgomery->modulus)) {
+        err = LIBINT_ERROR_BAD_ARGUMENT;
+        goto end;
+    }
+    *out = NULL;
+    err = E(montgomery_mul(libint, out, x, NULL, montgomery));
+    if (err) goto end;
+end:
+    return err;
+}
@@ -0,0 +1,628 @@
+#include "libint_internal.h"
+
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+
+// Number-theoretic transform multiplication splits operands into pieces of NTT_PIECE_BITS bits
+// and convolves them modulo two primes of the form c * 2^k + 1 with primitive root 3. A coefficient
+// of the convolution is less than 2^23 * (2^16)^2 = 2^55 < NTT_PRIME_0 * NTT_PRIME_1, so it is
+// restored exactly by the Chinese remainder theorem.
+#define NTT_PIECE_BITS 16
+#define NTT_PRIME_0 998244353u // 119 * 2^23 + 1
+#define NTT_PRIME_1 469762049u // 7 * 2^26 + 1
+#define NTT_PRIMITIVE_ROOT 3u
+#define NTT_MAX_SIZE (((size_t) 1) << 23)
+
+static size_t max_size(size_t a, size_t b) {
+    return a > b ? a : b;
+}
+
+// out = |x - y|, where x_size >= y_size and out has x_size words. Returns whether x < y.
+static bool abs_diff(LibintWord *out, const LibintWord *x, size_t x_size, const LibintWord *y, size_t y_size) {
+    size_t i = x_size;
+    while (i > y_size && !x[i - 1]) {
+        --i;
+    }
+    bool is_negative = i == y_size && libint_words_compare(x, y, y_size) < 0;
+    if (is_negative) {
+        libint_words_sub(out, y, y_size, x, y_size);
+        memset(out + y_size, 0, (x_size - y_size) * sizeof(LibintWord));
+    } else {
+        libint_words_sub(out, x, x_size, y, y_size);
+    }
+    return is_negative;
+}
+
+// out = (-1)^x_is_negative * x + (-1)^y_is_negative * y, where all arrays have size words and the
+// magnitude of the result fits into them. Returns whether the result is negative. out may be equal
+// to x or y.
+static bool signed_add(LibintWord *out, const LibintWord *x, bool x_is_negative,
+                       const LibintWord *y, bool y_is_negative, size_t size) {
+    if (x_is_negative == y_is_negative) {
+        LibintWord carry = libint_words_add(out, x, size, y, size);
+        assert(!carry);
+        (void) carry;
+        return x_is_negative;
+    }
+    int order = libint_words_compare(x, y, size);
+    if (order >= 0) {
+        libint_words_sub(out, x, size, y, size);
+        return order && x_is_negative;
+    }
+    libint_words_sub(out, y, size, x, size);
+    return y_is_negative;
+}
+
+// out += x * B^offset, where out has out_size words and the sum fits into them.
+static void add_at(LibintWord *out, size_t out_size, size_t offset, const LibintWord *x, size_t x_size) {
+    x_size = libint_words_normalized_size(x, x_size);
+    assert(offset + x_size <= out_size);
+    LibintWord carry = libint_words_add(out + offset, out + offset, out_size - offset, x, x_size);
+    assert(!carry);
+    (void) carry;
+}
+
+static size_t ntt_piece_count(size_t size) {
+    return (size * LIBINT_WORD_BITS + NTT_PIECE_BITS - 1) / NTT_PIECE_BITS;
+}
+
+// Transform size for the product of operands with x_size and y_size words, or 0 if it is too big.
+static size_t ntt_size(size_t x_size, size_t y_size) {
+    size_t coefficient_count = ntt_piece_count(x_size) + ntt_piece_count(y_size) - 1;
+    if (coefficient_count > NTT_MAX_SIZE) {
+        return 0;
+    }
+    size_t n = 1;
+    while (n < coefficient_count) {
+        n *= 2;
+    }
+    return n;
+}
+
+// Largest transform that operands of at most size words can use, or 0 if they never use one. Operands too long for a
+// transform of their own may still be multiplied by shorter ones in a transform of up to NTT_MAX_SIZE values.
+static size_t ntt_max_size(Libint *libint, size_t size) {
+    if (size < libint->mul_ntt_threshold) {
+        return 0;
+    }
+    size_t n = ntt_size(size, size);
+    if (!n && ntt_size(libint->mul_ntt_threshold, libint->mul_ntt_threshold)) {
+        n = NTT_MAX_SIZE;
+    }
+    return n;
+}
+
+// The transforms of both primes and one more for the second operand, plus room to align the scratch for uint32_t.
+static size_t ntt_scratch_size(size_t n) {
+    size_t bytes = 3 * n * sizeof(uint32_t) + sizeof(uint32_t);
+    return (bytes + sizeof(LibintWord) - 1) / sizeof(LibintWord);
+}
+
+size_t libint_words_mul_scratch_size(Libint *libint, size_t size) {
+    assert(libint);
+    size_t n = ntt_max_size(libint, size);
+    size_t result = n ? ntt_scratch_size(n) : 0;
+    if (size < libint->mul_karatsuba_threshold) {
+        return result;
+    }
+    // Karatsuba needs 6k + 2 words for its own temporaries. Unbalanced multiplication needs less.
+    size_t k = (size + 1) / 2;
+    result = max_size(result, 6 * k + 2 + libint_words_mul_scratch_size(libint, k));
+    if (size >= libint->mul_toom3_threshold) {
+        // Toom-3 needs 6 evaluations of k + 1 words and 6 products of 2k + 2 words.
+        k = (size + 2) / 3;
+        result = max_size(result, 18 * k + 18 + libint_words_mul_scratch_size(libint, k + 1));
+    }
+    return result;
+}
+
+static uint32_t pow_mod(uint32_t x, uint32_t power, uint32_t p) {
+    uint64_t result = 1;
+    uint64_t base = x;
+    while (power) {
+        if (power % 2) {
+            result = result * base % p;
+        }
+        base = base * base % p;
+        power /= 2;
+    }
+    return (uint32_t) result;
+}
+
+// Returns floor(w * 2^32 / p), the quotient of Shoup that multiplies by w modulo p without division.
+static uint32_t shoup_quotient(uint32_t w, uint32_t p) {
+    return (uint32_t) (((uint64_t) w << 32) / p);
+}
+
+// x * w mod p, where w < p < 2^31 and w_quotient = shoup_quotient(w, p).
+static uint32_t shoup_mul(uint32_t x, uint32_t w, uint32_t w_quotient, uint32_t p) {
+    uint32_t q = (uint32_t) (((uint64_t) x * w_quotient) >> 32);
+    uint32_t r = x * w - q * p;
+    return r >= p ? r - p : r;
+}
+
+// Returns -p^-1 mod 2^32 for odd p. Every step of Newton's iteration doubles the number of correct low bits, and
+// p^-1 = p mod 2^3.
+static uint32_t montgomery_inverse(uint32_t p) {
+    uint32_t inverse = p;
+    for (int i = 0; i < 4; ++i) {
+        inverse *= 2 - p * inverse;
+    }
+    return -inverse;
+}
+
+// x * y / 2^32 mod p, where x, y < p < 2^31 and inverse = montgomery_inverse(p).
+static uint32_t montgomery_mul(uint32_t x, uint32_t y, uint32_t p, uint32_t inverse) {
+    uint64_t t = (uint64_t) x * y;
+    uint32_t m = (uint32_t) t * inverse;
+    uint32_t r = (uint32_t) ((t + (uint64_t) m * p) >> 32);
+    return r >= p ? r - p : r;
+}
+
+// Fills the table of the transforms of up to size values modulo p, see ntt_transform. It is computed once for every
+// size, so it may divide.
+static void ntt_fill_table(uint32_t *table, size_t size, uint32_t p) {
+    uint32_t *quotients = table + size;
+    table[0] = 0;
+    for (size_t half = 1; half < size; half *= 2) {
+        uint64_t root = pow_mod(NTT_PRIMITIVE_ROOT, (p - 1) / (uint32_t) (2 * half), p);
+        table[half] = 1;
+        for (size_t j = 1; j < half; ++j) {
+            table[half + j] = (uint32_t) (table[half + j - 1] * root % p);
+        }
+    }
+    for (size_t i = 0; i < size; ++i) {
+        quotients[i] = shoup_quotient(table[i], p);
+    }
+}
+
+LibintError libint_words_mul_prepare(Libint *libint, size_t size) {
+    LibintError err = LIBINT_ERROR_OK;
+    uint32_t *tables[2] = { NULL, NULL };
+    bool is_suspended = false;
+    assert(libint);
+    size_t n = ntt_max_size(libint, size);
+    if (n <= libint->ntt_table_size) {
+        goto end;
+    }
+    // The tables outlive the arena.
+    ++libint->arena_suspended;
+    is_suspended = true;
+    for (size_t i = 0; i < 2; ++i) {
+        tables[i] = libint_malloc(libint, sizeof(uint32_t) * 2 * n);
+        if (!tables[i]) {
+            err = LIBINT_ERROR_OUT_OF_MEMORY;
+            goto end;
+        }
+        ntt_fill_table(tables[i], n, i ? NTT_PRIME_1 : NTT_PRIME_0);
+    }
+    for (size_t i = 0; i < 2; ++i) {
+        libint_free(libint, libint->ntt_tables[i]);
+        libint->ntt_tables[i] = tables[i];
+        tables[i] = NULL;
+    }
+    libint->ntt_table_size = n;
+end:
+    if (is_suspended) {
+        for (size_t i = 0; i < 2; ++i) {
+            libint_free(libint, tables[i]);
+        }
+        --libint->arena_suspended;
+    }
+    return err;
+}
+
+void libint_words_mul_tables_destroy(Libint *libint) {
+    for (size_t i = 0; i < 2; ++i) {
+        libint_free(libint, libint->ntt_tables[i]);
+        libint->ntt_tables[i] = NULL;
+    }
+    libint->ntt_table_size = 0;
+}
+
+// Iterative radix-2 transform of a in place. table has table_size >= n powers of the roots of unity modulo p followed
+// by their quotients of Shoup: the level that combines transforms of half values takes the powers of the root of
+// order 2 * half from table[half] to table[2 * half - 1].
+static void ntt_transform(uint32_t *a, size_t n, uint32_t p, const uint32_t *table, size_t table_size) {
+    for (size_t i = 1, j = 0; i < n; ++i) {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            uint32_t t = a[i];
+            a[i] = a[j];
+            a[j] = t;
+        }
+    }
+    for (size_t half = 1; half < n; half *= 2) {
+        const uint32_t *roots = table + half;
+        const uint32_t *root_quotients = table + table_size + half;
+        for (size_t i = 0; i < n; i += 2 * half) {
+            uint32_t *lo = a + i;
+            uint32_t *hi = a + i + half;
+            for (size_t j = 0; j < half; ++j) {
+                uint32_t u = lo[j];
+                uint32_t v = shoup_mul(hi[j], roots[j], root_quotients[j], p);
+                lo[j] = u + v < p ? u + v : u + v - p;
+                hi[j] = u >= v ? u - v : u + p - v;
+            }
+        }
+    }
+}
+
+static uint32_t ntt_get_piece(const LibintWord *x, size_t size, size_t index) {
+    if (LIBINT_WORD_BITS % NTT_PIECE_BITS == 0) {
+        size_t position = index * NTT_PIECE_BITS;
+        return (uint32_t) (x[position / LIBINT_WORD_BITS] >> (position % LIBINT_WORD_BITS))
+               & ((UINT32_C(1) << NTT_PIECE_BITS) - 1);
+    }
+    uint32_t piece = 0;
+    size_t position = index * NTT_PIECE_BITS;
+    for (unsigned bit = 0; bit < NTT_PIECE_BITS;) {
+        size_t word_index = position / LIBINT_WORD_BITS;
+        if (word_index >= size) {
+            break;
+        }
+        unsigned shift = position % LIBINT_WORD_BITS;
+        unsigned count = LIBINT_WORD_BITS - shift < NTT_PIECE_BITS - bit
+                ? (unsigned) LIBINT_WORD_BITS - shift : NTT_PIECE_BITS - bit;
+        piece |= ((uint32_t) (x[word_index] >> shift) & ((UINT32_C(1) << count) - 1)) << bit;
+        bit += count;
+        position += count;
+    }
+    return piece;
+}
+
+// Adds piece to x at the given piece index. The piece must not overlap already set bits.
+static void ntt_set_piece(LibintWord *x, size_t size, size_t index, uint32_t piece) {
+    size_t position = index * NTT_PIECE_BITS;
+    if (LIBINT_WORD_BITS % NTT_PIECE_BITS == 0) {
+        x[position / LIBINT_WORD_BITS] |= (LibintWord) piece << (position % LIBINT_WORD_BITS);
+        return;
+    }
+    for (unsigned bit = 0; bit < NTT_PIECE_BITS;) {
+        size_t word_index = position / LIBINT_WORD_BITS;
+        if (word_index >= size) {
+            assert(!(piece >> bit));
+            break;
+        }
+        unsigned shift = position % LIBINT_WORD_BITS;
+        unsigned count = LIBINT_WORD_BITS - shift < NTT_PIECE_BITS - bit
+                ? (unsigned) LIBINT_WORD_BITS - shift : NTT_PIECE_BITS - bit;
+        x[word_index] |= (LibintWord) ((piece >> bit) & ((UINT32_C(1) << count) - 1)) << shift;
+        bit += count;
+        position += count;
+    }
+}
+
+// Cyclic convolution of the pieces of x and y modulo the prime with the given index into a. If y is NULL x is squared
+// and b is unused.
+static void ntt_convolve(Libint *libint, const LibintWord *x, size_t x_size, const LibintWord *y, size_t y_size,
+                         size_t n, size_t prime_index, uint32_t *a, uint32_t *b) {
+    uint32_t p = prime_index ? NTT_PRIME_1 : NTT_PRIME_0;
+    const uint32_t *table = libint->ntt_tables[prime_index];
+    size_t table_size = libint->ntt_table_size;
+    size_t x_piece_count = ntt_piece_count(x_size);
+    for (size_t i = 0; i < n; ++i) {
+        a[i] = i < x_piece_count ? ntt_get_piece(x, x_size, i) : 0;
+    }
+    ntt_transform(a, n, p, table, table_size);
+    if (y) {
+        size_t y_piece_count = ntt_piece_count(y_size);
+        for (size_t i = 0; i < n; ++i) {
+            b[i] = i < y_piece_count ? ntt_get_piece(y, y_size, i) : 0;
+        }
+        ntt_transform(b, n, p, table, table_size);
+    } else {
+        b = a;
+    }
+    // The inverse transform is scaled by 1 / n, which is p - (p - 1) / n because n divides p - 1. Two Montgomery
+    // multiplications by 2^-32 cancel its factor 2^64 mod p.
+    uint32_t inverse = montgomery_inverse(p);
+    uint64_t r = ((uint64_t) 1 << 32) % p;
+    uint32_t scale = (uint32_t) ((p - (p - 1) / n) * (r * r % p) % p);
+    for (size_t i = 0; i < n; ++i) {
+        a[i] = montgomery_mul(montgomery_mul(a[i], b[i], p, inverse), scale, p, inverse);
+    }
+    // The inverse transform is the forward one with the values at i and n - i exchanged.
+    ntt_transform(a, n, p, table, table_size);
+    for (size_t i = 1, j = n - 1; i < j; ++i, --j) {
+        uint32_t t = a[i];
+        a[i] = a[j];
+        a[j] = t;
+    }
+}
+
+// out = x * y, or out = x^2 if y is NULL.
+static void mul_ntt(Libint *libint, const LibintWord *x, size_t x_size, const LibintWord *y, size_t y_size,
+                    LibintWord *out, size_t n, LibintWord *scratch) {
+    assert(n <= libint->ntt_table_size);
+    uintptr_t address = (uintptr_t) scratch;
+    address = (address + sizeof(uint32_t) - 1) / sizeof(uint32_t) * sizeof(uint32_t);
+    uint32_t *a0 = (uint32_t *) address;
+    uint32_t *a1 = a0 + n;
+    uint32_t *b = a1 + n;
+    ntt_convolve(libint, x, x_size, y, y_size, n, 0, a0, b);
+    ntt_convolve(libint, x, x_size, y, y_size, n, 1, a1, b);
+    // c = r0 + p0 * ((r1 - r0) / p0 mod p1)
+    uint32_t p0_inverse = pow_mod(NTT_PRIME_0 % NTT_PRIME_1, NTT_PRIME_1 - 2, NTT_PRIME_1);
+    uint32_t p0_inverse_quotient = shoup_quotient(p0_inverse, NTT_PRIME_1);
+    if (!y) {
+        y_size = x_size;
+    }
+    size_t out_size = x_size + y_size;
+    size_t out_piece_count = ntt_piece_count(out_size);
+    size_t coefficient_count = ntt_piece_count(x_size) + ntt_piece_count(y_size) - 1;
+    memset(out, 0, out_size * sizeof(LibintWord));
+    uint64_t accumulator = 0;
+    for (size_t i = 0; i < out_piece_count; ++i) {
+        if (i < coefficient_count) {
+            uint32_t r0 = a0[i];
+            uint32_t r1 = a1[i];
+            // r0 < p0 < 3 * p1
+            uint32_t r0_mod_p1 = r0 >= NTT_PRIME_1 ? r0 - NTT_PRIME_1 : r0;
+            r0_mod_p1 = r0_mod_p1 >= NTT_PRIME_1 ? r0_mod_p1 - NTT_PRIME_1 : r0_mod_p1;
+            uint32_t difference = r1 >= r0_mod_p1 ? r1 - r0_mod_p1 : r1 + NTT_PRIME_1 - r0_mod_p1;
+            uint64_t d = shoup_mul(difference, p0_inverse, p0_inverse_quotient, NTT_PRIME_1);
+            accumulator += r0 + d * NTT_PRIME_0;
+        }
+        ntt_set_piece(out, out_size, i, (uint32_t) (accumulator & ((UINT32_C(1) << NTT_PIECE_BITS) - 1)));
+        accumulator >>= NTT_PIECE_BITS;
+    }
+    assert(!accumulator);
+}
+
+// Multiplies x by y chunk by chunk, where each chunk of x has y_size words.
+static void mul_unbalanced(Libint *libint, LibintWord *out, const LibintWord *x, size_t x_size,
+                           const LibintWord *y, size_t y_size, LibintWord *scratch) {
+    LibintWord *t = scratch;
+    scratch += 2 * y_size;
+    libint_words_mul(libint, out, x, y_size, y, y_size, scratch);
+    for (size_t i = y_size; i < x_size; i += y_size) {
+        size_t chunk_size = x_size - i < y_size ? x_size - i : y_size;
+        libint_words_mul(libint, t, y, y_size, x + i, chunk_size, scratch);
+        memcpy(out + i + y_size, t + y_size, chunk_size * sizeof(LibintWord));
+        LibintWord carry = libint_words_add(out + i, out + i, y_size + chunk_size, t, y_size);
+        assert(!carry);
+        (void) carry;
+    }
+}
+
+// x = x1 * B^k + x0, y = y1 * B^k + y0
+// x * y = x1 * y1 * B^2k + (x0 * y0 + x1 * y1 - (x0 - x1) * (y0 - y1)) * B^k + x0 * y0
+static void mul_karatsuba(Libint *libint, LibintWord *out, const LibintWord *x, size_t x_size,
+                          const LibintWord *y, size_t y_size, LibintWord *scratch) {
+    size_t k = (x_size + 1) / 2;
+    assert(k < y_size && y_size <= x_size);
+    size_t out_size = x_size + y_size;
+    LibintWord *dx = scratch;
+    LibintWord *dy = dx + k;
+    LibintWord *t = dy + k;
+    LibintWord *m = t + 2 * k;
+    scratch = m + 2 * k + 2;
+    bool is_negative_dx = abs_diff(dx, x, k, x + k, x_size - k);
+    bool is_negative_dy = abs_diff(dy, y, k, y + k, y_size - k);
+    libint_words_mul(libint, out, x, k, y, k, scratch);
+    libint_words_mul(libint, out + 2 * k, x + k, x_size - k, y + k, y_size - k, scratch);
+    libint_words_mul(libint, t, dx, k, dy, k, scratch);
+    m[2 * k] = libint_words_add(m, out, 2 * k, out + 2 * k, out_size - 2 * k);
+    m[2 * k + 1] = 0;
+    if (is_negative_dx == is_negative_dy) {
+        LibintWord borrow = libint_words_sub(m, m, 2 * k + 2, t, 2 * k);
+        assert(!borrow);
+        (void) borrow;
+    } else {
+        LibintWord carry = libint_words_add(m, m, 2 * k + 2, t, 2 * k);
+        assert(!carry);
+        (void) carry;
+    }
+    add_at(out, out_size, k, m, 2 * k + 2);
+}
+
+// Evaluates a2 * t^2 + a1 * t + a0 at t = 1, -1 and -2. a0 and a1 have k words, a2 has a2_size words,
+// results and temporaries have k + 1 words.
+static void toom3_evaluate(const LibintWord *a, size_t k, size_t a2_size, LibintWord *p1,
+                           LibintWord *pm1, bool *is_negative_pm1, LibintWord *pm2, bool *is_negative_pm2,
+                           LibintWord *t1, LibintWord *t2) {
+    const LibintWord *a0 = a;
+    const LibintWord *a1 = a + k;
+    const LibintWord *a2 = a + 2 * k;
+    size_t size = k + 1;
+    t1[k] = libint_words_add(t1, a0, k, a2, a2_size);
+    memcpy(t2, a1, k * sizeof(LibintWord));
+    t2[k] = 0;
+    LibintWord carry = libint_words_add(p1, t1, size, t2, size);
+    assert(!carry);
+    (void) carry;
+    *is_negative_pm1 = signed_add(pm1, t1, false, t2, true, size);
+    // p(-2) = 2 * (p(-1) + a2) - a0
+    memcpy(t1, a2, a2_size * sizeof(LibintWord));
+    memset(t1 + a2_size, 0, (size - a2_size) * sizeof(LibintWord));
+    *is_negative_pm2 = signed_add(pm2, pm1, *is_negative_pm1, t1, false, size);
+    carry = libint_words_lshift(pm2, pm2, size, 1);
+    assert(!carry);
+    memcpy(t2, a0, k * sizeof(LibintWord));
+    t2[k] = 0;
+    *is_negative_pm2 = signed_add(pm2, pm2, *is_negative_pm2, t2, true, size);
+}
+
+// Restores the coefficients of the product from its values r0, r1, rm1, rm2 and rinf at 0, 1, -1, -2 and
+// infinity, and adds them up into out. All values and t have 2k + 2 words and are overwritten.
+static void toom3_interpolate(LibintWord *out, size_t out_size, size_t k, LibintWord *r0, LibintWord *r1,
+                              LibintWord *rm1, bool is_negative_rm1, LibintWord *rm2, bool is_negative_rm2,
+                              LibintWord *rinf, LibintWord *t) {
+    size_t product_size = 2 * k + 2;
+    // r3 = (r(-2) - r(1)) / 3, stored in rm2
+    bool is_negative_r3 = signed_add(rm2, rm2, is_negative_rm2, r1, true, product_size);
+    LibintWord remainder = libint_words_div_word(rm2, rm2, product_size, 3);
+    assert(!remainder);
+    (void) remainder;
+    // r1 = (r(1) - r(-1)) / 2
+    bool is_negative_r1 = signed_add(r1, r1, false, rm1, !is_negative_rm1, product_size);
+    libint_words_rshift(r1, r1, product_size, 1);
+    // r2 = r(-1) - r(0), stored in rm1
+    bool is_negative_r2 = signed_add(rm1, rm1, is_negative_rm1, r0, true, product_size);
+    // r3 = (r2 - r3) / 2 + 2 * r(inf)
+    is_negative_r3 = signed_add(rm2, rm1, is_negative_r2, rm2, !is_negative_r3, product_size);
+    libint_words_rshift(rm2, rm2, product_size, 1);
+    LibintWord carry = libint_words_lshift(t, rinf, product_size, 1);
+    assert(!carry);
+    (void) carry;
+    is_negative_r3 = signed_add(rm2, rm2, is_negative_r3, t, false, product_size);
+    // r2 = r2 + r1 - r(inf)
+    is_negative_r2 = signed_add(rm1, rm1, is_negative_r2, r1, is_negative_r1, product_size);
+    is_negative_r2 = signed_add(rm1, rm1, is_negative_r2, rinf, true, product_size);
+    // r1 = r1 - r3
+    is_negative_r1 = signed_add(r1, r1, is_negative_r1, rm2, !is_negative_r3, product_size);
+    assert(!is_negative_r1 && !is_negative_r2 && !is_negative_r3);
+    (void) is_negative_r1;
+    (void) is_negative_r2;
+    memset(out, 0, out_size * sizeof(LibintWord));
+    add_at(out, out_size, 0, r0, product_size);
+    add_at(out, out_size, k, r1, product_size);
+    add_at(out, out_size, 2 * k, rm1, product_size);
+    add_at(out, out_size, 3 * k, rm2, product_size);
+    add_at(out, out_size, 4 * k, rinf, product_size);
+}
+
+// Toom-Cook 3-way multiplication evaluating at 0, 1, -1, -2 and infinity with the interpolation
+// sequence of Bodrato.
+static void mul_toom3(Libint *libint, LibintWord *out, const LibintWord *x, size_t x_size,
+                      const LibintWord *y, size_t y_size, LibintWord *scratch) {
+    size_t k = (x_size + 2) / 3;
+    assert(2 * k < y_size && y_size <= x_size);
+    size_t out_size = x_size + y_size;
+    size_t x2_size = x_size - 2 * k;
+    size_t y2_size = y_size - 2 * k;
+    size_t size = k + 1;
+    size_t product_size = 2 * size;
+    LibintWord *xp1 = scratch;
+    LibintWord *xm1 = xp1 + size;
+    LibintWord *xm2 = xm1 + size;
+    LibintWord *yp1 = xm2 + size;
+    LibintWord *ym1 = yp1 + size;
+    LibintWord *ym2 = ym1 + size;
+    LibintWord *r0 = ym2 + size;
+    LibintWord *r1 = r0 + product_size;
+    LibintWord *rm1 = r1 + product_size;
+    LibintWord *rm2 = rm1 + product_size;
+    LibintWord *rinf = rm2 + product_size;
+    LibintWord *t = rinf + product_size;
+    scratch = t + product_size;
+    bool is_negative_xm1, is_negative_xm2, is_negative_ym1, is_negative_ym2;
+    toom3_evaluate(x, k, x2_size, xp1, xm1, &is_negative_xm1, xm2, &is_negative_xm2, r0, rinf);
+    toom3_evaluate(y, k, y2_size, yp1, ym1, &is_negative_ym1, ym2, &is_negative_ym2, r0, rinf);
+    libint_words_mul(libint, r0, x, k, y, k, scratch);
+    memset(r0 + 2 * k, 0, (product_size - 2 * k) * sizeof(LibintWord));
+    libint_words_mul(libint, r1, xp1, size, yp1, size, scratch);
+    libint_words_mul(libint, rm1, xm1, size, ym1, size, scratch);
+    bool is_negative_rm1 = is_negative_xm1 != is_negative_ym1;
+    libint_words_mul(libint, rm2, xm2, size, ym2, size, scratch);
+    bool is_negative_rm2 = is_negative_xm2 != is_negative_ym2;
+    libint_words_mul(libint, rinf, x + 2 * k, x2_size, y + 2 * k, y2_size, scratch);
+    memset(rinf + x2_size + y2_size, 0, (product_size - x2_size - y2_size) * sizeof(LibintWord));
+    toom3_interpolate(out, out_size, k, r0, r1, rm1, is_negative_rm1, rm2, is_negative_rm2, rinf, t);
+}
+
+void libint_words_mul(Libint *libint, LibintWord *out, const LibintWord *x, size_t x_size,
+                      const LibintWord *y, size_t y_size, LibintWord *scratch) {
+    assert(libint && out && x && y && y_size && x_size >= y_size);
+    size_t n = 0;
+    if (y_size >= libint->mul_ntt_threshold && (n = ntt_size(x_size, y_size))) {
+        mul_ntt(libint, x, x_size, y, y_size, out, n, scratch);
+    } else if (y_size < libint->mul_karatsuba_threshold) {
+        libint_words_mul_basecase(out, x, x_size, y, y_size);
+    } else if (y_size >= libint->mul_toom3_threshold && y_size > 2 * ((x_size + 2) / 3)) {
+        mul_toom3(libint, out, x, x_size, y, y_size, scratch);
+    } else if (y_size > (x_size + 1) / 2) {
+        mul_karatsuba(libint, out, x, x_size, y, y_size, scratch);
+    } else {
+        mul_unbalanced(libint, out, x, x_size, y, y_size, scratch);
+    }
+}
+
+size_t libint_words_sqr_scratch_size(Libint *libint, size_t size) {
+    assert(libint);
+    size_t n = ntt_max_size(libint, size);
+    size_t result = n ? ntt_scratch_size(n) : 0;
+    if (size < libint->sqr_karatsuba_threshold) {
+        return result;
+    }
+    // Karatsuba squaring needs 5k + 2 words for its own temporaries.
+    size_t k = (size + 1) / 2;
+    result = max_size(result, 5 * k + 2 + libint_words_sqr_scratch_size(libint, k));
+    if (size >= libint->sqr_toom3_threshold) {
+        // Toom-3 squaring needs 3 evaluations of k + 1 words and 6 squares of 2k + 2 words.
+        k = (size + 2) / 3;
+        result = max_size(result, 15 * k + 15 + libint_words_sqr_scratch_size(libint, k + 1));
+    }
+    return result;
+}
+
+// x = x1 * B^k + x0
+// x^2 = x1^2 * B^2k + (x0^2 + x1^2 - (x0 - x1)^2) * B^k + x0^2
+static void sqr_karatsuba(Libint *libint, LibintWord *out, const LibintWord *x, size_t size, LibintWord *scratch) {
+    size_t k = (size + 1) / 2;
+    assert(k < size);
+    size_t out_size = 2 * size;
+    LibintWord *d = scratch;
+    LibintWord *t = d + k;
+    LibintWord *m = t + 2 * k;
+    scratch = m + 2 * k + 2;
+    abs_diff(d, x, k, x + k, size - k);
+    libint_words_sqr(libint, out, x, k, scratch);
+    libint_words_sqr(libint, out + 2 * k, x + k, size - k, scratch);
+    libint_words_sqr(libint, t, d, k, scratch);
+    m[2 * k] = libint_words_add(m, out, 2 * k, out + 2 * k, out_size - 2 * k);
+    m[2 * k + 1] = 0;
+    LibintWord borrow = libint_words_sub(m, m, 2 * k + 2, t, 2 * k);
+    assert(!borrow);
+    (void) borrow;
+    add_at(out, out_size, k, m, 2 * k + 2);
+}
+
+static void sqr_toom3(Libint *libint, LibintWord *out, const LibintWord *x, size_t size, LibintWord *scratch) {
+    size_t k = (size + 2) / 3;
+    assert(2 * k < size);
+    size_t out_size = 2 * size;
+    size_t x2_size = size - 2 * k;
+    size_t evaluation_size = k + 1;
+    size_t product_size = 2 * evaluation_size;
+    LibintWord *xp1 = scratch;
+    LibintWord *xm1 = xp1 + evaluation_size;
+    LibintWord *xm2 = xm1 + evaluation_size;
+    LibintWord *r0 = xm2 + evaluation_size;
+    LibintWord *r1 = r0 + product_size;
+    LibintWord *rm1 = r1 + product_size;
+    LibintWord *rm2 = rm1 + product_size;
+    LibintWord *rinf = rm2 + product_size;
+    LibintWord *t = rinf + product_size;
+    scratch = t + product_size;
+    bool is_negative_xm1, is_negative_xm2;
+    toom3_evaluate(x, k, x2_size, xp1, xm1, &is_negative_xm1, xm2, &is_negative_xm2, r0, rinf);
+    libint_words_sqr(libint, r0, x, k, scratch);
+    memset(r0 + 2 * k, 0, (product_size - 2 * k) * sizeof(LibintWord));
+    libint_words_sqr(libint, r1, xp1, evaluation_size, scratch);
+    libint_words_sqr(libint, rm1, xm1, evaluation_size, scratch);
+    libint_words_sqr(libint, rm2, xm2, evaluation_size, scratch);
+    libint_words_sqr(libint, rinf, x + 2 * k, x2_size, scratch);
+    memset(rinf + 2 * x2_size, 0, (product_size - 2 * x2_size) * sizeof(LibintWord));
+    toom3_interpolate(out, out_size, k, r0, r1, rm1, false, rm2, false, rinf, t);
+}
+
+void libint_words_sqr(Libint *libint, LibintWord *out, const LibintWord *x, size_t size, LibintWord *scratch) {
+    assert(libint && out && x && size);
+    size_t n = 0;
+    if (size >= libint->mul_ntt_threshold && (n = ntt_size(size, size))) {
+        mul_ntt(libint, x, size, NULL, 0, out, n, scratch);
+    } else if (size < libint->sqr_karatsuba_threshold) {
+        libint_words_sqr_basecase(out, x, size);
+    } else if (size >= libint->sqr_toom3_threshold && size > 2 * ((size + 2) / 3)) {
+        sqr_toom3(libint, out, x, size, scratch);
+    } else {
+        sqr_karatsuba(libint, out, x, size, scratch);
+    }
+}
@@ -0,0 +1,189 @@
+#include "libint_internal.h"
+
+#include <assert.h>
+#include <string.h>
+
+// Residues modulo a number, every one has size words. Odd moduli use Montgomery multiplication and keep the residues
+// in the Montgomery form, other ones use Barrett reduction.
+typedef struct {
+    size_t size;
+    LibintUnsigned *modulus;
+    LibintMontgomery *montgomery;
+    LibintBarrett *barrett;
+} Residues;
+
+static size_t residues_scratch_size(Libint *libint, const Residues *residues) {
+    if (residues->montgomery) {
+        return libint_words_montgomery_scratch_size(libint, residues->size);
+    }
+    return libint_words_barrett_scratch_size(libint, residues->size);
+}
+
+// out = x * y, or x^2 if y is NULL. out may be equal to x or y.
+static void residues_mul(Libint *libint, const Residues *residues, LibintWord *out, const LibintWord *x,
+                         const LibintWord *y, LibintWord *scratch) {
+    if (residues->montgomery) {
+        if (y) {
+            libint_words_montgomery_mul(libint, out, x, y, residues->montgomery, scratch);
+        } else {
+            libint_words_montgomery_sqr(libint, out, x, residues->montgomery, scratch);
+        }
+    } else {
+        if (y) {
+            libint_words_barrett_mul(libint, out, x, y, residues->barrett, scratch);
+        } else {
+            libint_words_barrett_sqr(libint, out, x, residues->barrett, scratch);
+        }
+    }
+}
+
+// Bits of the exponent per window, so that the table of odd powers pays off.
+static unsigned window_bits(size_t bits) {
+    return bits > 671 ? 6 : bits > 239 ? 5 : bits > 79 ? 4 : bits > 23 ? 3 : bits > 7 ? 2 : 1;
+}
+
+static unsigned bit(const LibintUnsigned *x, size_t i) {
+    return (x->ptr[i / LIBINT_WORD_BITS] >> (i % LIBINT_WORD_BITS)) & 1;
+}
+
+// out = base^power mod modulus, where base is a residue. out is not in the Montgomery form.
+static LibintError residues_pow(
+        Libint *libint, const Residues *residues, LibintUnsigned **out, LibintUnsigned *base, LibintUnsigned *power) {
+    LibintError err = LIBINT_ERROR_OK;
+    LibintWord *result_ptr = NULL;
+    LibintWord *buffer = NULL;
+    bool is_zero;
+    err = E(libint_unsigned_is_zero(libint, power, &is_zero));
+    if (err) goto end;
+    if (is_zero) {
+        int order;
+        err = E(libint_unsigned_compare_ui(libint, residues->modulus, 1, &order));
+        if (err) goto end;
+        err = E(libint_unsigned_create(libint, out, order > 0));
+        goto end;
+    }
+    size_t msb;
+    err = E(libint_unsigned_most_significant_bit(libint, power, &msb));
+    if (err) goto end;
+    unsigned window = window_bits(msb + 1);
+    size_t table_size = (size_t) 1 << (window - 1);
+    size_t size = residues->size;
+    // Barrett reduction multiplies operands of up to size + 2 words.
+    err = E(libint_words_mul_prepare(libint, size + 2));
+    if (err) goto end;
+    result_ptr = libint_malloc(libint, sizeof(LibintWord) * size);
+    // The table of odd powers base, base^3, ..., base^(2 * table_size - 1), the square of base and the scratch.
+    size_t scratch_size = residues_scratch_size(libint, residues);
+    buffer = libint_malloc(libint, sizeof(LibintWord) * ((table_size + 1) * size + scratch_size));
+    if (!result_ptr || !buffer) {
+        err = LIBINT_ERROR_OUT_OF_MEMORY;
+        goto end;
+    }
+    LibintWord *table = buffer;
+    LibintWord *square = table + table_size * size;
+    LibintWord *scratch = square + size;
+    memcpy(table, base->ptr, sizeof(LibintWord) * base->size);
+    memset(table + base->size, 0, sizeof(LibintWord) * (size - base->size));
+    if (table_size > 1) {
+        residues_mul(libint, residues, square, table, NULL, scratch);
+        for (size_t i = 1; i < table_size; ++i) {
+            residues_mul(libint, residues, table + i * size, table + (i - 1) * size, square, scratch);
+        }
+    }
+    // Goes from the most significant bit. Every window starts and ends with a set bit, so it is an odd power from the
+    // table.
+    bool is_first = true;
+    size_t i = msb + 1;
+    while (i--) {
+        if (!bit(power, i)) {
+            residues_mul(libint, residues, result_ptr, result_ptr, NULL, scratch);
+            continue;
+        }
+        size_t low = i + 1 >= window ? i + 1 - window : 0;
+        while (!bit(power, low)) {
+            ++low;
+        }
+        size_t value = 0;
+        for (size_t j = i + 1; j-- > low;) {
+            value = value << 1 | bit(power, j);
+        }
+        const LibintWord *odd_power = table + (value >> 1) * size;
+        if (is_first) {
+            memcpy(result_ptr, odd_power, sizeof(LibintWord) * size);
+            is_first = false;
+        } else {
+            for (size_t j = low; j <= i; ++j) {
+                residues_mul(libint, residues, result_ptr, result_ptr, NULL, scratch);
+            }
+            residues_mul(libint, residues, result_ptr, result_ptr, odd_power, scratch);
+        }
+        i = low;
+    }
+    if (residues->montgomery) {
+        // Leaves the Montgomery form.
+        memcpy(scratch, result_ptr, sizeof(LibintWord) * size);
+        memset(scratch + size, 0, sizeof(LibintWord) * size);
+        libint_words_montgomery_reduce(result_ptr, scratch, residues->montgomery);
+    }
+    err = E(libint_unsigned_construct(libint, out, libint_words_normalized_size(result_ptr, size), result_ptr));
+    if (err) goto end;
+    result_ptr = NULL;
+end:
+    libint_free(libint, result_ptr);
+    libint_free(libint, buffer);
+    return err;
+}
+
+LibintError libint_unsigned_powmod(
+        Libint *libint, LibintUnsigned **out, LibintUnsigned *x, LibintUnsigned *power, LibintUnsigned *modulus) {
+    LibintError err = LIBINT_ERROR_OK;
+    Residues residues = { 0, modulus, NULL, NULL };
+    LibintUnsigned *base = NULL;
+    if (!libint || !out || !x || !power || !modulus) {
+        err = LIBINT_ERROR_BAD_ARGUMENT;
+        goto end;
+    }
+    *out = NULL;
+    residues.size = modulus->size;
+    // Montgomery multiplication needs no correction steps, but only works for odd moduli.
+    if (modulus->ptr[0] & 1) {
+        err = E(libint_montgomery_create(libint, &residues.montgomery, modulus));
+        if (err) goto end;
+        err = E(libint_montgomery_to_form(libint, &base, x, residues.montgomery));
+        if (err) goto end;
+    } else {
+        err = E(libint_barrett_create(libint, &residues.barrett, modulus));
+        if (err) goto end;
+        err = E(libint_barrett_mod(libint, &base, x, residues.barrett));
+        if (err) goto end;
+    }
+    err = E(residues_pow(libint, &residues, out, base, power));
+    if (err) goto end;
+end:
+    E(libint_montgomery_destroy(libint, &residues.montgomery));
+    E(libint_barrett_destroy(libint, &residues.barrett));
+    E(libint_unsigned_destroy(libint, &base));
+    return err;
+}
+
+LibintError libint_barrett_pow(
+        Libint *libint, LibintUnsigned **out, LibintUnsigned *x, LibintUnsigned *power, LibintBarrett *barrett) {
+    LibintError err = LIBINT_ERROR_OK;
+    if (!libint || !out || !x || !power || !barrett) {
+        err = LIBINT_ERROR_BAD_ARGUMENT;
+        goto end;
+    }
+    *out = NULL;
+    bool is_reduced;
+    err = E(libint_unsigned_less(libint, x, barrett->modulus, &is_reduced));
+    if (err) goto end;
+    if (!is_reduced) {
+        err = LIBINT_ERROR_BAD_ARGUMENT;
+        goto end;
+    }
+    Residues residues = { barrett->size, barrett->modulus, NULL, barrett };
+    err = E(residues_pow(libint, &residues, out, x, power));
+    if (err) goto end;
+end:
+    return err;
+}
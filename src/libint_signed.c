@@ -22,19 +22,48 @@ LibintError libint_handle_internal_error(LibintError err) {
 }
 
 LibintError libint_start(Libint **libint) {
+    return libint_start_with_allocator(libint, &libint_system_allocator);
+}
+
+LibintError libint_start_with_allocator(Libint **libint, const LibintAllocator *allocator) {
     LibintError err = LIBINT_ERROR_OK;
     Libint *result = NULL;
     intmax_t i = 0;
     intmax_t j = 0;
-    if (!libint) {
+    if (!libint || !allocator || !allocator->allocate || !allocator->reallocate || !allocator->deallocate) {
         err = LIBINT_ERROR_BAD_ARGUMENT;
         goto end;
     }
-    result = malloc(sizeof(Libint));
+    result = allocator->allocate(allocator->state, sizeof(Libint));
     if (!result) {
         err = LIBINT_ERROR_OUT_OF_MEMORY;
         goto end;
     }
+    result->allocator = *allocator;
+    result->arena = NULL;
+    result->arena_chunk_size = 0;
+    result->arena_suspended = 0;
+    result->mul_karatsuba_threshold = 32;
+    result->mul_toom3_threshold = 128;
+    result->mul_ntt_threshold = 81920;
+    result->sqr_karatsuba_threshold = 48;
+    result->sqr_toom3_threshold = 128;
+    result->div_burnikel_ziegler_threshold = 48;
+    result->div_newton_threshold = 65536;
+    result->divider_newton_threshold = 1024;
+    result->to_string_recursive_threshold = 32;
+    result->from_string_recursive_threshold = 64;
+    result->gcd_lehmer_threshold = 2;
+    result->gcd_half_gcd_threshold = 768;
+    result->half_gcd_recursive_threshold = 128;
+    result->ntt_tables[0] = NULL;
+    result->ntt_tables[1] = NULL;
+    result->ntt_table_size = 0;
+    for (int base = 0; base < 17; ++base) {
+        result->radix_powers[base] = NULL;
+        result->radix_dividers[base] = NULL;
+        result->radix_power_counts[base] = 0;
+    }
     intmax_t n = sizeof(result->libint_unsigned_constants) / sizeof(LibintUnsigned *);
     for (; i < n; ++i) {
         err = E(libint_unsigned_create(result, &result->libint_unsigned_constants[i], i));
@@ -57,7 +86,7 @@ end:
         for (size_t t = i; t--;) {
             E(libint_unsigned_destroy(result, &result->libint_unsigned_constants[t]));
         }
-        free(result);
+        allocator->deallocate(allocator->state, result);
     }
     return err;
 }
@@ -69,6 +98,11 @@ LibintError libint_finish(Libint **libint) {
         goto end;
     }
     if (*libint) {
+        if ((*libint)->arena) {
+            E(libint_arena_end(*libint));
+        }
+        libint_radix_powers_destroy(*libint);
+        libint_words_mul_tables_destroy(*libint);
         size_t n = sizeof((*libint)->libint_unsigned_constants) / sizeof(LibintUnsigned *);
         for (size_t i = 0; i < n; ++i) {
             E(libint_unsigned_destroy(*libint, &(*libint)->libint_unsigned_constants[i]));
@@ -77,44 +111,223 @@ LibintError libint_finish(Libint **libint) {
         for (size_t i = 0; i < n; ++i) {
             E(libint_destroy(*libint, &(*libint)->libint_constants[i]));
         }
-        free(*libint);
+        LibintAllocator allocator = (*libint)->allocator;
+        allocator.deallocate(allocator.state, *libint);
         *libint = NULL;
     }
 end:
     return err;
 }
 
+LibintError libint_get_threshold(Libint *libint, LibintThreshold threshold, size_t *value) {
+    LibintError err = LIBINT_ERROR_OK;
+    if (!libint || !value) {
+        err = LIBINT_ERROR_BAD_ARGUMENT;
+        goto end;
+    }
+    switch (threshold) {
+    case LIBINT_THRESHOLD_MUL_KARATSUBA:
+        *value = libint->mul_karatsuba_threshold;
+        break;
+    case LIBINT_THRESHOLD_MUL_TOOM3:
+        *value = libint->mul_toom3_threshold;
+        break;
+    case LIBINT_THRESHOLD_MUL_NTT:
+        *value = libint->mul_ntt_threshold;
+        break;
+    case LIBINT_THRESHOLD_SQR_KARATSUBA:
+        *value = libint->sqr_karatsuba_threshold;
+        break;
+    case LIBINT_THRESHOLD_SQR_TOOM3:
+        *value = libint->sqr_toom3_threshold;
+        break;
+    case LIBINT_THRESHOLD_DIV_BURNIKEL_ZIEGLER:
+        *value = libint->div_burnikel_ziegler_threshold;
+        break;
+    case LIBINT_THRESHOLD_DIV_NEWTON:
+        *value = libint->div_newton_threshold;
+        break;
+    case LIBINT_THRESHOLD_DIVIDER_NEWTON:
+        *value = libint->divider_newton_threshold;
+        break;
+    case LIBINT_THRESHOLD_TO_STRING_RECURSIVE:
+        *value = libint->to_string_recursive_threshold;
+        break;
+    case LIBINT_THRESHOLD_FROM_STRING_RECURSIVE:
+        *value = libint->from_string_recursive_threshold;
+        break;
+    case LIBINT_THRESHOLD_GCD_LEHMER:
+        *value = libint->gcd_lehmer_threshold;
+        break;
+    case LIBINT_THRESHOLD_GCD_HALF_GCD:
+        *value = libint->gcd_half_gcd_threshold;
+        break;
+    case LIBINT_THRESHOLD_HALF_GCD_RECURSIVE:
+        *value = libint->half_gcd_recursive_threshold;
+        break;
+    default:
+        err = LIBINT_ERROR_BAD_ARGUMENT;
+        goto end;
+    }
+end:
+    return err;
+}
+
+LibintError libint_set_threshold(Libint *libint, LibintThreshold threshold, size_t value) {
+    LibintError err = LIBINT_ERROR_OK;
+    if (!libint) {
+        err = LIBINT_ERROR_BAD_ARGUMENT;
+        goto end;
+    }
+    switch (threshold) {
+    case LIBINT_THRESHOLD_MUL_KARATSUBA:
+        if (value < 2) {
+            err = LIBINT_ERROR_BAD_ARGUMENT;
+            goto end;
+        }
+        libint->mul_karatsuba_threshold = value;
+        break;
+    case LIBINT_THRESHOLD_MUL_TOOM3:
+        if (value < 3) {
+            err = LIBINT_ERROR_BAD_ARGUMENT;
+            goto end;
+        }
+        libint->mul_toom3_threshold = value;
+        break;
+    case LIBINT_THRESHOLD_MUL_NTT:
+        if (value < 1) {
+            err = LIBINT_ERROR_BAD_ARGUMENT;
+            goto end;
+        }
+        libint->mul_ntt_threshold = value;
+        break;
+    case LIBINT_THRESHOLD_SQR_KARATSUBA:
+        if (value < 2) {
+            err = LIBINT_ERROR_BAD_ARGUMENT;
+            goto end;
+        }
+        libint->sqr_karatsuba_threshold = value;
+        break;
+    case LIBINT_THRESHOLD_SQR_TOOM3:
+        if (value < 3) {
+            err = LIBINT_ERROR_BAD_ARGUMENT;
+            goto end;
+        }
+        libint->sqr_toom3_threshold = value;
+        break;
+    case LIBINT_THRESHOLD_DIV_BURNIKEL_ZIEGLER:
+        if (value < 2) {
+            err = LIBINT_ERROR_BAD_ARGUMENT;
+            goto end;
+        }
+        libint->div_burnikel_ziegler_threshold = value;
+        break;
+    case LIBINT_THRESHOLD_DIV_NEWTON:
+        if (value < 3) {
+            err = LIBINT_ERROR_BAD_ARGUMENT;
+            goto end;
+        }
+        libint->div_newton_threshold = value;
+        break;
+    case LIBINT_THRESHOLD_DIVIDER_NEWTON:
+        if (value < 3) {
+            err = LIBINT_ERROR_BAD_ARGUMENT;
+            goto end;
+        }
+        libint->divider_newton_threshold = value;
+        break;
+    case LIBINT_THRESHOLD_TO_STRING_RECURSIVE:
+        if (value < 2) {
+            err = LIBINT_ERROR_BAD_ARGUMENT;
+            goto end;
+        }
+        libint->to_string_recursive_threshold = value;
+        break;
+    case LIBINT_THRESHOLD_FROM_STRING_RECURSIVE:
+        if (value < 2) {
+            err = LIBINT_ERROR_BAD_ARGUMENT;
+            goto end;
+        }
+        libint->from_string_recursive_threshold = value;
+        break;
+    case LIBINT_THRESHOLD_GCD_LEHMER:
+        if (value < 1) {
+            err = LIBINT_ERROR_BAD_ARGUMENT;
+            goto end;
+        }
+        libint->gcd_lehmer_threshold = value;
+        break;
+    case LIBINT_THRESHOLD_GCD_HALF_GCD:
+        if (value < 4) {
+            err = LIBINT_ERROR_BAD_ARGUMENT;
+            goto end;
+        }
+        libint->gcd_half_gcd_threshold = value;
+        break;
+    case LIBINT_THRESHOLD_HALF_GCD_RECURSIVE:
+        if (value < 4) {
+            err = LIBINT_ERROR_BAD_ARGUMENT;
+            goto end;
+        }
+        libint->half_gcd_recursive_threshold = value;
+        break;
+    default:
+        err = LIBINT_ERROR_BAD_ARGUMENT;
+        goto end;
+    }
+end:
+    return err;
+}
+
 static void normalize(LibintSigned *x) {
-    if (!x || !x->magnitude) {
+    if (!x) {
         abort();
     }
-    if (x->magnitude->size > 1) {
+    if (x->magnitude.size > 1) {
         return;
     }
-    if (x->magnitude->ptr[0]) {
+    if (x->magnitude.ptr[0]) {
         return;
     }
     x->is_negative = false;
 }
 
+// Stores the value into x without allocation, see libint_unsigned_set_uintmax.
+static void set_scalar(LibintSigned *x, bool is_negative, uintmax_t magnitude) {
+    x->is_negative = is_negative;
+    libint_unsigned_set_uintmax(&x->magnitude, magnitude);
+    normalize(x);
+}
+
+static uintmax_t magnitude_of(intmax_t value) {
+    return value < 0 ? -(uintmax_t) value : (uintmax_t) value;
+}
+
+// Allocates a zero, its magnitude keeps small values without another allocation.
+static LibintError allocate(Libint *libint, LibintSigned **x) {
+    LibintError err = LIBINT_ERROR_OK;
+    *x = libint_malloc(libint, sizeof(LibintSigned));
+    if (!*x) {
+        err = LIBINT_ERROR_OUT_OF_MEMORY;
+        goto end;
+    }
+    (*x)->is_negative = false;
+    libint_unsigned_init(&(*x)->magnitude);
+    (*x)->magnitude.outside_arena = libint_outside_arena(libint);
+end:
+    return err;
+}
+
 LibintError libint_create(Libint *libint, LibintSigned **x, intmax_t value) {
     LibintError err = LIBINT_ERROR_OK;
-    LibintUnsigned *magnitude = NULL;
     if (!libint || !x) {
         err = LIBINT_ERROR_BAD_ARGUMENT;
         goto end;
     }
-    bool is_negative = value < 0;
-    if (is_negative) {
-        value = -value;
-    }
-    err = E(libint_unsigned_create(libint, &magnitude, (uintmax_t) value));
-    if (err) goto end;
-    err = E(libint_construct(libint, x, is_negative, magnitude));
+    err = E(allocate(libint, x));
     if (err) goto end;
-    magnitude = NULL;
+    set_scalar(*x, value < 0, magnitude_of(value));
 end:
-    E(libint_unsigned_destroy(libint, &magnitude));
     return err;
 }
 
@@ -126,7 +339,7 @@ LibintError libint_to_intmax(Libint *libint, LibintSigned *x, intmax_t *value) {
     }
     *value = 0;
     uintmax_t magnitude_value;
-    err = E(libint_unsigned_to_uintmax(libint, x->magnitude, &magnitude_value));
+    err = E(libint_unsigned_to_uintmax(libint, &x->magnitude, &magnitude_value));
     if (err) goto end;
     if (x->is_negative) {
         if (magnitude_value > -(uintmax_t) INTMAX_MIN) {
@@ -180,7 +393,7 @@ LibintError libint_to_string(Libint *libint, LibintSigned *x, int base, char **o
     if (!libint || !x || !out || !out_size) {
         return LIBINT_ERROR_BAD_ARGUMENT;
     }
-    return E(libint_to_string_helper(libint, x->is_negative, x->magnitude, base, out, out_size));
+    return E(libint_to_string_helper(libint, x->is_negative, &x->magnitude, base, out, out_size));
 }
 
 LibintError libint_construct(Libint *libint, LibintSigned **x, bool is_negative, LibintUnsigned *magnitude) {
@@ -190,13 +403,15 @@ LibintError libint_construct(Libint *libint, LibintSigned **x, bool is_negative,
         goto end;
     }
     *x = NULL;
-    LibintSigned *out = malloc(sizeof(LibintSigned));
+    LibintSigned *out = libint_malloc(libint, sizeof(LibintSigned));
     if (!out) {
         err = LIBINT_ERROR_OUT_OF_MEMORY;
         goto end;
     }
     out->is_negative = is_negative;
-    out->magnitude = magnitude;
+    out->magnitude.outside_arena = libint_outside_arena(libint);
+    libint_unsigned_move(&out->magnitude, magnitude);
+    libint_free(libint, magnitude);
     normalize(out);
     assert(LIBINT_SIGNED_INVARIANT(out));
     *x = out;
@@ -205,10 +420,23 @@ end:
 }
 
 LibintError libint_copy(Libint *libint, LibintSigned **out, LibintSigned *x) {
+    LibintError err = LIBINT_ERROR_OK;
+    LibintSigned *result = NULL;
     if (!libint || !out || !x) {
-        return LIBINT_ERROR_BAD_ARGUMENT;
+        err = LIBINT_ERROR_BAD_ARGUMENT;
+        goto end;
     }
-    return E(libint_add(libint, out, libint->libint_constants[0], x));
+    *out = NULL;
+    err = E(allocate(libint, &result));
+    if (err) goto end;
+    err = E(libint_unsigned_share(libint, &result->magnitude, &x->magnitude));
+    if (err) goto end;
+    result->is_negative = x->is_negative;
+    *out = result;
+    result = NULL;
+end:
+    E(libint_destroy(libint, &result));
+    return err;
 }
 
 LibintError libint_destroy(Libint *libint, LibintSigned **x) {
@@ -218,323 +446,444 @@ LibintError libint_destroy(Libint *libint, LibintSigned **x) {
         goto end;
     }
     if (*x) {
-        E(libint_unsigned_destroy(libint, &(*x)->magnitude));
-        free(*x);
+        libint_unsigned_release(libint, &(*x)->magnitude);
+        libint_free(libint, *x);
         *x = NULL;
     }
 end:
     return err;
 }
 
-LibintError libint_add(Libint *libint, LibintSigned **out, LibintSigned *x, LibintSigned *y) {
+// out = x + y or out = x - y, out may be x or y.
+static LibintError add_into(Libint *libint, LibintSigned *out, LibintSigned *x, LibintSigned *y, bool subtract) {
     LibintError err = LIBINT_ERROR_OK;
-    LibintUnsigned *out_magnitude = NULL;
-    if (!libint || !out || !x || !y) {
-        err = LIBINT_ERROR_BAD_ARGUMENT;
-        goto end;
-    }
-    *out = NULL;
-    if (x->is_negative == y->is_negative) {
-        err = E(libint_unsigned_add(libint, &out_magnitude, x->magnitude, y->magnitude));
-        if (err) goto end;
-        err = E(libint_construct(libint, out, x->is_negative, out_magnitude));
+    LibintUnsigned *a = &x->magnitude;
+    LibintUnsigned *b = &y->magnitude;
+    bool is_negative = x->is_negative;
+    bool y_is_negative = y->is_negative != subtract;
+    if (is_negative == y_is_negative) {
+        err = E(libint_unsigned_add_into(libint, &out->magnitude, a, b));
         if (err) goto end;
     } else {
         int order;
-        err = E(libint_unsigned_compare(libint, x->magnitude, y->magnitude, &order));
+        err = E(libint_unsigned_compare(libint, a, b, &order));
         if (err) goto end;
-        bool is_negative = x->is_negative;
         if (order < 0) {
-            LibintSigned *t = x;
-            x = y;
-            y = t;
-            is_negative = !is_negative;
+            LibintUnsigned *t = a;
+            a = b;
+            b = t;
+            is_negative = y_is_negative;
         }
-        err = E(libint_unsigned_sub(libint, &out_magnitude, x->magnitude, y->magnitude));
-        if (err) goto end;
-        err = E(libint_construct(libint, out, is_negative, out_magnitude));
+        err = E(libint_unsigned_sub_into(libint, &out->magnitude, a, b));
         if (err) goto end;
     }
-    out_magnitude = NULL;
+    out->is_negative = is_negative;
+    normalize(out);
+    assert(LIBINT_SIGNED_INVARIANT(out));
 end:
-    E(libint_unsigned_destroy(libint, &out_magnitude));
     return err;
 }
 
-LibintError libint_sub(Libint *libint, LibintSigned **out, LibintSigned *x, LibintSigned *y) {
+LibintError libint_add(Libint *libint, LibintSigned **out, LibintSigned *x, LibintSigned *y) {
     LibintError err = LIBINT_ERROR_OK;
+    LibintSigned *result = NULL;
     if (!libint || !out || !x || !y) {
         err = LIBINT_ERROR_BAD_ARGUMENT;
         goto end;
     }
-    y->is_negative = !y->is_negative;
-    err = E(libint_add(libint, out, x, y));
-    y->is_negative = !y->is_negative;
+    *out = NULL;
+    err = E(allocate(libint, &result));
+    if (err) goto end;
+    err = E(add_into(libint, result, x, y, false));
     if (err) goto end;
+    *out = result;
+    result = NULL;
 end:
+    E(libint_destroy(libint, &result));
     return err;
 }
 
-LibintError libint_mul(Libint *libint, LibintSigned **out, LibintSigned *x, LibintSigned *y) {
+LibintError libint_sub(Libint *libint, LibintSigned **out, LibintSigned *x, LibintSigned *y) {
     LibintError err = LIBINT_ERROR_OK;
-    LibintUnsigned *out_magnitude = NULL;
+    LibintSigned *result = NULL;
     if (!libint || !out || !x || !y) {
         err = LIBINT_ERROR_BAD_ARGUMENT;
         goto end;
     }
-    bool is_negative = x->is_negative != y->is_negative;
-    err = E(libint_unsigned_mul(libint, &out_magnitude, x->magnitude, y->magnitude));
+    *out = NULL;
+    err = E(allocate(libint, &result));
     if (err) goto end;
-    err = E(libint_construct(libint, out, is_negative, out_magnitude));
+    err = E(add_into(libint, result, x, y, true));
     if (err) goto end;
-    out_magnitude = NULL;
+    *out = result;
+    result = NULL;
 end:
-    E(libint_unsigned_destroy(libint, &out_magnitude));
+    E(libint_destroy(libint, &result));
     return err;
 }
 
-LibintError libint_div_trunc(Libint *libint, LibintSigned **out, LibintSigned *x, LibintSigned *y) {
+LibintError libint_mul(Libint *libint, LibintSigned **out, LibintSigned *x, LibintSigned *y) {
     LibintError err = LIBINT_ERROR_OK;
-    LibintSigned *remainder = NULL;
+    LibintSigned *result = NULL;
     if (!libint || !out || !x || !y) {
         err = LIBINT_ERROR_BAD_ARGUMENT;
         goto end;
     }
-    err = E(libint_div_mod_trunc(libint, out, &remainder, x, y));
+    *out = NULL;
+    err = E(allocate(libint, &result));
     if (err) goto end;
+    err = E(libint_mul_into(libint, result, x, y));
+    if (err) goto end;
+    *out = result;
+    result = NULL;
 end:
-    E(libint_destroy(libint, &remainder));
+    E(libint_destroy(libint, &result));
     return err;
 }
 
-LibintError libint_mod_trunc(Libint *libint, LibintSigned **out, LibintSigned *x, LibintSigned *y) {
+LibintError libint_sqr(Libint *libint, LibintSigned **out, LibintSigned *x) {
     LibintError err = LIBINT_ERROR_OK;
-    LibintSigned *quotient = NULL;
-    if (!libint || !out || !x || !y) {
+    LibintSigned *result = NULL;
+    if (!libint || !out || !x) {
         err = LIBINT_ERROR_BAD_ARGUMENT;
         goto end;
     }
-    err = E(libint_div_mod_trunc(libint, &quotient, out, x, y));
+    *out = NULL;
+    err = E(allocate(libint, &result));
     if (err) goto end;
+    err = E(libint_sqr_into(libint, result, x));
+    if (err) goto end;
+    *out = result;
+    result = NULL;
 end:
-    E(libint_destroy(libint, &quotient));
+    E(libint_destroy(libint, &result));
     return err;
 }
 
-LibintError libint_div_mod_trunc(Libint *libint, LibintSigned **quotient, LibintSigned **remainder, LibintSigned *x,
-                                 LibintSigned *y) {
+typedef enum {
+    ROUNDING_TRUNC,
+    ROUNDING_FLOOR,
+    ROUNDING_EUCLID,
+} Rounding;
+
+// Computes the quotient rounded as requested and the matching remainder x - quotient * y with a single division of
+// the magnitudes. Rounding away from the truncated quotient only adds 1 to its magnitude and replaces the remainder
+// magnitude r by |y| - r. The results are written into quotient and remainder, either of which may be NULL if it is
+// not needed. They may be x, but not y, which is still needed for the remainder.
+static LibintError div_mod_into(Libint *libint, LibintSigned *quotient, LibintSigned *remainder, LibintSigned *x,
+                                LibintSigned *y, Rounding rounding) {
     LibintError err = LIBINT_ERROR_OK;
-    LibintUnsigned *quotient_magnitude = NULL;
-    LibintUnsigned *remainder_magnitude = NULL;
-    if (!libint || !quotient || !remainder || !x || !y) {
-        err = LIBINT_ERROR_BAD_ARGUMENT;
-        goto end;
-    }
+    assert(quotient != y && remainder != y);
+    // The remainder decides the rounding even if it is not returned.
+    LibintUnsigned remainder_scratch;
+    libint_unsigned_init(&remainder_scratch);
+    LibintUnsigned *remainder_magnitude = remainder ? &remainder->magnitude : &remainder_scratch;
     bool is_negative_quotient = x->is_negative != y->is_negative;
     bool is_negative_remainder = x->is_negative;
-    err = E(libint_unsigned_div_mod(libint, &quotient_magnitude, &remainder_magnitude, x->magnitude, y->magnitude));
-    if (err) goto end;
-    err = E(libint_construct(libint, quotient, is_negative_quotient, quotient_magnitude));
+    bool is_negative_x = x->is_negative;
+    err = E(libint_unsigned_div_mod_into(
+            libint, quotient ? &quotient->magnitude : NULL, remainder_magnitude, &x->magnitude, &y->magnitude));
     if (err) goto end;
-    quotient_magnitude = NULL;
-    err = E(libint_construct(libint, remainder, is_negative_remainder, remainder_magnitude));
+    bool is_zero;
+    err = E(libint_unsigned_is_zero(libint, remainder_magnitude, &is_zero));
     if (err) goto end;
-    remainder_magnitude = NULL;
+    bool round_away = false;
+    if (!is_zero && rounding == ROUNDING_FLOOR) {
+        // The remainder takes the sign of y.
+        round_away = is_negative_quotient;
+        is_negative_remainder = y->is_negative;
+    } else if (!is_zero && rounding == ROUNDING_EUCLID) {
+        // The remainder is never negative.
+        round_away = is_negative_x;
+        is_negative_remainder = false;
+    }
+    if (round_away && quotient) {
+        LibintUnsigned one;
+        libint_unsigned_set_uintmax(&one, 1);
+        err = E(libint_unsigned_add_into(libint, &quotient->magnitude, &quotient->magnitude, &one));
+        if (err) goto end;
+    }
+    if (round_away && remainder) {
+        err = E(libint_unsigned_sub_into(libint, remainder_magnitude, &y->magnitude, remainder_magnitude));
+        if (err) goto end;
+    }
+    if (quotient) {
+        quotient->is_negative = is_negative_quotient;
+        normalize(quotient);
+        assert(LIBINT_SIGNED_INVARIANT(quotient));
+    }
+    if (remainder) {
+        remainder->is_negative = is_negative_remainder;
+        normalize(remainder);
+        assert(LIBINT_SIGNED_INVARIANT(remainder));
+    }
 end:
-    E(libint_unsigned_destroy(libint, &quotient_magnitude));
-    E(libint_unsigned_destroy(libint, &remainder_magnitude));
+    libint_unsigned_release(libint, &remainder_scratch);
     return err;
 }
 
-LibintError libint_div_floor(Libint *libint, LibintSigned **out, LibintSigned *x, LibintSigned *y) {
+// Same as div_mod_into, but allocates the results.
+static LibintError div_mod(Libint *libint, LibintSigned **quotient, LibintSigned **remainder, LibintSigned *x,
+                           LibintSigned *y, Rounding rounding) {
     LibintError err = LIBINT_ERROR_OK;
-    LibintSigned *result = NULL;
-    LibintUnsigned *result_magnitude = NULL;
-    LibintUnsigned *remainder = NULL;
-    if (!libint || !out || !x || !y) {
-        err = LIBINT_ERROR_BAD_ARGUMENT;
-        goto end;
+    LibintSigned *result_quotient = NULL;
+    LibintSigned *result_remainder = NULL;
+    if (quotient) {
+        err = E(allocate(libint, &result_quotient));
+        if (err) goto end;
     }
-    *out = NULL;
-    bool is_negative_quotient = x->is_negative != y->is_negative;
-    err = E(libint_unsigned_div_mod(libint, &result_magnitude, &remainder, x->magnitude, y->magnitude));
-    if (err) goto end;
-    err = E(libint_construct(libint, &result, is_negative_quotient, result_magnitude));
-    if (err) goto end;
-    result_magnitude = NULL;
-    int order = 0;
-    err = E(libint_unsigned_compare(libint, remainder, libint->libint_unsigned_constants[0], &order));
-    if (err) goto end;
-    if (is_negative_quotient && order == 1) {
-        err = E(libint_sub_replace(libint, &result, libint->libint_constants[1]));
+    if (remainder) {
+        err = E(allocate(libint, &result_remainder));
         if (err) goto end;
     }
-    *out = result;
-    result = NULL;
+    err = E(div_mod_into(libint, result_quotient, result_remainder, x, y, rounding));
+    if (err) goto end;
+    if (quotient) {
+        *quotient = result_quotient;
+        result_quotient = NULL;
+    }
+    if (remainder) {
+        *remainder = result_remainder;
+        result_remainder = NULL;
+    }
 end:
-    E(libint_unsigned_destroy(libint, &result_magnitude));
-    E(libint_unsigned_destroy(libint, &remainder));
-    E(libint_destroy(libint, &result));
+    E(libint_destroy(libint, &result_quotient));
+    E(libint_destroy(libint, &result_remainder));
     return err;
 }
 
-// x % y = x - y * floor(x / y)
+LibintError libint_div_trunc(Libint *libint, LibintSigned **out, LibintSigned *x, LibintSigned *y) {
+    if (!libint || !out || !x || !y) {
+        return LIBINT_ERROR_BAD_ARGUMENT;
+    }
+    *out = NULL;
+    return E(div_mod(libint, out, NULL, x, y, ROUNDING_TRUNC));
+}
+
+LibintError libint_mod_trunc(Libint *libint, LibintSigned **out, LibintSigned *x, LibintSigned *y) {
+    if (!libint || !out || !x || !y) {
+        return LIBINT_ERROR_BAD_ARGUMENT;
+    }
+    *out = NULL;
+    return E(div_mod(libint, NULL, out, x, y, ROUNDING_TRUNC));
+}
+
+LibintError libint_div_mod_trunc(Libint *libint, LibintSigned **quotient, LibintSigned **remainder, LibintSigned *x,
+                                 LibintSigned *y) {
+    if (!libint || !quotient || !remainder || !x || !y) {
+        return LIBINT_ERROR_BAD_ARGUMENT;
+    }
+    *quotient = NULL;
+    *remainder = NULL;
+    return E(div_mod(libint, quotient, remainder, x, y, ROUNDING_TRUNC));
+}
+
+LibintError libint_div_floor(Libint *libint, LibintSigned **out, LibintSigned *x, LibintSigned *y) {
+    if (!libint || !out || !x || !y) {
+        return LIBINT_ERROR_BAD_ARGUMENT;
+    }
+    *out = NULL;
+    return E(div_mod(libint, out, NULL, x, y, ROUNDING_FLOOR));
+}
+
 LibintError libint_mod_floor(Libint *libint, LibintSigned **out, LibintSigned *x, LibintSigned *y) {
-    LibintError err = LIBINT_ERROR_OK;
-    LibintSigned *result = NULL;
     if (!libint || !out || !x || !y) {
-        err = LIBINT_ERROR_BAD_ARGUMENT;
-        goto end;
+        return LIBINT_ERROR_BAD_ARGUMENT;
     }
-    err = E(libint_div_floor(libint, &result, x, y));
-    if (err) goto end;
-    err = E(libint_mul_replace(libint, &result, y));
-    if (err) goto end;
-    err = E(libint_rsub_replace(libint, &result, x));
-    if (err) goto end;
-    *out = result;
-    result = NULL;
-end:
-    E(libint_destroy(libint, &result));
-    return err;
+    *out = NULL;
+    return E(div_mod(libint, NULL, out, x, y, ROUNDING_FLOOR));
 }
 
 LibintError libint_div_mod_floor(Libint *libint, LibintSigned **quotient, LibintSigned **remainder, LibintSigned *x,
                                  LibintSigned *y) {
-    LibintError err = LIBINT_ERROR_OK;
-    LibintSigned *result_quotient = NULL;
-    LibintSigned *result_remainder = NULL;
     if (!libint || !quotient || !remainder || !x || !y) {
+        return LIBINT_ERROR_BAD_ARGUMENT;
+    }
+    *quotient = NULL;
+    *remainder = NULL;
+    return E(div_mod(libint, quotient, remainder, x, y, ROUNDING_FLOOR));
+}
+
+LibintError libint_div_euclid(Libint *libint, LibintSigned **out, LibintSigned *x, LibintSigned *y) {
+    if (!libint || !out || !x || !y) {
+        return LIBINT_ERROR_BAD_ARGUMENT;
+    }
+    *out = NULL;
+    return E(div_mod(libint, out, NULL, x, y, ROUNDING_EUCLID));
+}
+
+LibintError libint_mod_euclid(Libint *libint, LibintSigned **out, LibintSigned *x, LibintSigned *y) {
+    if (!libint || !out || !x || !y) {
+        return LIBINT_ERROR_BAD_ARGUMENT;
+    }
+    *out = NULL;
+    return E(div_mod(libint, NULL, out, x, y, ROUNDING_EUCLID));
+}
+
+LibintError libint_div_mod_euclid(Libint *libint, LibintSigned **quotient, LibintSigned **remainder, LibintSigned *x,
+                                  LibintSigned *y) {
+    if (!libint || !quotient || !remainder || !x || !y) {
+        return LIBINT_ERROR_BAD_ARGUMENT;
+    }
+    *quotient = NULL;
+    *remainder = NULL;
+    return E(div_mod(libint, quotient, remainder, x, y, ROUNDING_EUCLID));
+}
+
+LibintError libint_copy_into(Libint *libint, LibintSigned *out, LibintSigned *x) {
+    LibintError err = LIBINT_ERROR_OK;
+    if (!libint || !out || !x) {
         err = LIBINT_ERROR_BAD_ARGUMENT;
         goto end;
     }
-    err = E(libint_div_floor(libint, &result_quotient, x, y));
-    if (err) goto end;
-    err = E(libint_mod_floor(libint, &result_remainder, x, y));
+    err = E(libint_unsigned_copy_into(libint, &out->magnitude, &x->magnitude));
     if (err) goto end;
-    *quotient = result_quotient;
-    result_quotient = NULL;
-    *remainder = result_remainder;
-    result_remainder = NULL;
+    out->is_negative = x->is_negative;
 end:
-    E(libint_destroy(libint, &result_quotient));
-    E(libint_destroy(libint, &result_remainder));
     return err;
 }
 
-LibintError libint_add_replace(Libint *libint, LibintSigned **x, LibintSigned *y) {
+LibintError libint_add_into(Libint *libint, LibintSigned *out, LibintSigned *x, LibintSigned *y) {
+    if (!libint || !out || !x || !y) {
+        return LIBINT_ERROR_BAD_ARGUMENT;
+    }
+    return E(add_into(libint, out, x, y, false));
+}
+
+LibintError libint_sub_into(Libint *libint, LibintSigned *out, LibintSigned *x, LibintSigned *y) {
+    if (!libint || !out || !x || !y) {
+        return LIBINT_ERROR_BAD_ARGUMENT;
+    }
+    return E(add_into(libint, out, x, y, true));
+}
+
+LibintError libint_mul_into(Libint *libint, LibintSigned *out, LibintSigned *x, LibintSigned *y) {
     LibintError err = LIBINT_ERROR_OK;
-    LibintSigned *result = NULL;
-    if (!libint || !x || !y) {
+    if (!libint || !out || !x || !y) {
         err = LIBINT_ERROR_BAD_ARGUMENT;
         goto end;
     }
-    err = E(libint_add(libint, &result, *x, y));
+    bool is_negative = x->is_negative != y->is_negative;
+    err = E(libint_unsigned_mul_into(libint, &out->magnitude, &x->magnitude, &y->magnitude));
     if (err) goto end;
-    E(libint_destroy(libint, x));
-    *x = result;
-    result = NULL;
+    out->is_negative = is_negative;
+    normalize(out);
+    assert(LIBINT_SIGNED_INVARIANT(out));
 end:
-    E(libint_destroy(libint, &result));
     return err;
 }
 
-LibintError libint_sub_replace(Libint *libint, LibintSigned **x, LibintSigned *y) {
+LibintError libint_sqr_into(Libint *libint, LibintSigned *out, LibintSigned *x) {
     LibintError err = LIBINT_ERROR_OK;
-    LibintSigned *result = NULL;
-    if (!libint || !x || !y) {
+    if (!libint || !out || !x) {
         err = LIBINT_ERROR_BAD_ARGUMENT;
         goto end;
     }
-    err = E(libint_sub(libint, &result, *x, y));
+    err = E(libint_unsigned_sqr_into(libint, &out->magnitude, &x->magnitude));
     if (err) goto end;
-    E(libint_destroy(libint, x));
-    *x = result;
-    result = NULL;
+    out->is_negative = false;
+    assert(LIBINT_SIGNED_INVARIANT(out));
 end:
-    E(libint_destroy(libint, &result));
     return err;
 }
 
-LibintError libint_rsub_replace(Libint *libint, LibintSigned **x, LibintSigned *y) {
+// Computes the quotient or the remainder into out. If out is y, the result is computed into a temporary number first,
+// because y is needed to the end.
+static LibintError div_into(Libint *libint, LibintSigned *out, LibintSigned *x, LibintSigned *y, bool is_remainder,
+                            Rounding rounding) {
     LibintError err = LIBINT_ERROR_OK;
-    LibintSigned *result = NULL;
-    if (!libint || !x || !y) {
+    LibintSigned result;
+    result.is_negative = false;
+    libint_unsigned_init(&result.magnitude);
+    if (!libint || !out || !x || !y) {
         err = LIBINT_ERROR_BAD_ARGUMENT;
         goto end;
     }
-    LibintSigned *a = y;
-    LibintSigned *b = *x;
-    err = E(libint_sub(libint, &result, a, b));
+    result.magnitude.outside_arena = out->magnitude.outside_arena;
+    LibintSigned *target = out == y ? &result : out;
+    err = E(div_mod_into(libint, is_remainder ? NULL : target, is_remainder ? target : NULL, x, y, rounding));
     if (err) goto end;
-    E(libint_destroy(libint, x));
-    *x = result;
-    result = NULL;
+    if (target == &result) {
+        libint_unsigned_release(libint, &out->magnitude);
+        libint_unsigned_move(&out->magnitude, &result.magnitude);
+        out->is_negative = result.is_negative;
+    }
 end:
-    E(libint_destroy(libint, &result));
+    libint_unsigned_release(libint, &result.magnitude);
     return err;
 }
 
+LibintError libint_div_trunc_into(Libint *libint, LibintSigned *out, LibintSigned *x, LibintSigned *y) {
+    return div_into(libint, out, x, y, false, ROUNDING_TRUNC);
+}
+
+LibintError libint_mod_trunc_into(Libint *libint, LibintSigned *out, LibintSigned *x, LibintSigned *y) {
+    return div_into(libint, out, x, y, true, ROUNDING_TRUNC);
+}
+
+LibintError libint_div_floor_into(Libint *libint, LibintSigned *out, LibintSigned *x, LibintSigned *y) {
+    return div_into(libint, out, x, y, false, ROUNDING_FLOOR);
+}
+
+LibintError libint_mod_floor_into(Libint *libint, LibintSigned *out, LibintSigned *x, LibintSigned *y) {
+    return div_into(libint, out, x, y, true, ROUNDING_FLOOR);
+}
+
+LibintError libint_div_euclid_into(Libint *libint, LibintSigned *out, LibintSigned *x, LibintSigned *y) {
+    return div_into(libint, out, x, y, false, ROUNDING_EUCLID);
+}
+
+LibintError libint_mod_euclid_into(Libint *libint, LibintSigned *out, LibintSigned *x, LibintSigned *y) {
+    return div_into(libint, out, x, y, true, ROUNDING_EUCLID);
+}
+
+LibintError libint_add_replace(Libint *libint, LibintSigned **x, LibintSigned *y) {
+    if (!libint || !x || !y) {
+        return LIBINT_ERROR_BAD_ARGUMENT;
+    }
+    return E(add_into(libint, *x, *x, y, false));
+}
+
+LibintError libint_sub_replace(Libint *libint, LibintSigned **x, LibintSigned *y) {
+    if (!libint || !x || !y) {
+        return LIBINT_ERROR_BAD_ARGUMENT;
+    }
+    return E(add_into(libint, *x, *x, y, true));
+}
+
+LibintError libint_rsub_replace(Libint *libint, LibintSigned **x, LibintSigned *y) {
+    if (!libint || !x || !y) {
+        return LIBINT_ERROR_BAD_ARGUMENT;
+    }
+    return E(add_into(libint, *x, y, *x, true));
+}
+
 LibintError libint_mul_replace(Libint *libint, LibintSigned **x, LibintSigned *y) {
-    LibintError err = LIBINT_ERROR_OK;
-    LibintSigned *result = NULL;
     if (!libint || !x || !y) {
-        err = LIBINT_ERROR_BAD_ARGUMENT;
-        goto end;
+        return LIBINT_ERROR_BAD_ARGUMENT;
     }
-    err = E(libint_mul(libint, &result, *x, y));
-    if (err) goto end;
-    E(libint_destroy(libint, x));
-    *x = result;
-    result = NULL;
-end:
-    E(libint_destroy(libint, &result));
-    return LIBINT_ERROR_OK;
+    return E(libint_mul_into(libint, *x, *x, y));
 }
 
 LibintError libint_div_replace(Libint *libint, LibintSigned **x, LibintSigned *y) {
-    LibintError err = LIBINT_ERROR_OK;
-    LibintSigned *result = NULL;
     if (!libint || !x || !y) {
-        err = LIBINT_ERROR_BAD_ARGUMENT;
-        goto end;
-    }
-    err = E(libint_div_trunc(libint, &result, *x, y));
-    if (err) {
-        return err;
+        return LIBINT_ERROR_BAD_ARGUMENT;
     }
-    E(libint_destroy(libint, x));
-    *x = result;
-    result = NULL;
-end:
-    E(libint_destroy(libint, &result));
-    return LIBINT_ERROR_OK;
+    return E(div_into(libint, *x, *x, y, false, ROUNDING_TRUNC));
 }
 
 LibintError libint_rdiv_replace(Libint *libint, LibintSigned **x, LibintSigned *y) {
-    LibintError err = LIBINT_ERROR_OK;
-    LibintSigned *result;
     if (!libint || !x || !y) {
-        err = LIBINT_ERROR_BAD_ARGUMENT;
-        goto end;
+        return LIBINT_ERROR_BAD_ARGUMENT;
     }
-    LibintSigned *a = y;
-    LibintSigned *b = *x;
-    err = E(libint_div_trunc(libint, &result, a, b));
-    if (err) goto end;
-    E(libint_destroy(libint, x));
-    *x = result;
-    result = NULL;
-end:
-    E(libint_destroy(libint, &result));
-    return LIBINT_ERROR_OK;
+    return E(div_into(libint, *x, y, *x, false, ROUNDING_TRUNC));
 }
 
 LibintError libint_is_zero(Libint *libint, LibintSigned *x, bool *is_zero) {
     if (!libint || !x || !is_zero) {
         return LIBINT_ERROR_BAD_ARGUMENT;
     }
-    return E(libint_unsigned_is_zero(libint, x->magnitude, is_zero));
+    return E(libint_unsigned_is_zero(libint, &x->magnitude, is_zero));
 }
 
 LibintError libint_compare(Libint *libint, LibintSigned *x, LibintSigned *y, int *order) {
@@ -545,7 +894,7 @@ LibintError libint_compare(Libint *libint, LibintSigned *x, LibintSigned *y, int
     }
     if (x->is_negative) {
         if (y->is_negative) {
-            err = E(libint_unsigned_compare(libint, y->magnitude, x->magnitude, order));
+            err = E(libint_unsigned_compare(libint, &y->magnitude, &x->magnitude, order));
             if (err) goto end;
         } else {
             *order = -1;
@@ -554,7 +903,7 @@ LibintError libint_compare(Libint *libint, LibintSigned *x, LibintSigned *y, int
         if (y->is_negative) {
             *order = 1;
         } else {
-            err = E(libint_unsigned_compare(libint, x->magnitude, y->magnitude, order));
+            err = E(libint_unsigned_compare(libint, &x->magnitude, &y->magnitude, order));
             if (err) goto end;
         }
     }
@@ -589,3 +938,123 @@ LibintError libint_less_or_equal(Libint *libint, LibintSigned *x, LibintSigned *
 end:
     return err;
 }
+
+LibintError libint_add_si(Libint *libint, LibintSigned **out, LibintSigned *x, intmax_t y) {
+    if (!libint || !out || !x) {
+        return LIBINT_ERROR_BAD_ARGUMENT;
+    }
+    LibintSigned operand;
+    set_scalar(&operand, y < 0, magnitude_of(y));
+    return E(libint_add(libint, out, x, &operand));
+}
+
+LibintError libint_sub_si(Libint *libint, LibintSigned **out, LibintSigned *x, intmax_t y) {
+    if (!libint || !out || !x) {
+        return LIBINT_ERROR_BAD_ARGUMENT;
+    }
+    LibintSigned operand;
+    set_scalar(&operand, y > 0, magnitude_of(y));
+    return E(libint_add(libint, out, x, &operand));
+}
+
+LibintError libint_mul_si(Libint *libint, LibintSigned **out, LibintSigned *x, intmax_t y) {
+    if (!libint || !out || !x) {
+        return LIBINT_ERROR_BAD_ARGUMENT;
+    }
+    LibintSigned operand;
+    set_scalar(&operand, y < 0, magnitude_of(y));
+    return E(libint_mul(libint, out, x, &operand));
+}
+
+LibintError libint_mul_ui(Libint *libint, LibintSigned **out, LibintSigned *x, uintmax_t y) {
+    if (!libint || !out || !x) {
+        return LIBINT_ERROR_BAD_ARGUMENT;
+    }
+    LibintSigned operand;
+    set_scalar(&operand, false, y);
+    return E(libint_mul(libint, out, x, &operand));
+}
+
+LibintError libint_div_mod_ui(Libint *libint, LibintSigned **out, LibintSigned *x, uintmax_t y, uintmax_t *remainder) {
+    LibintError err = LIBINT_ERROR_OK;
+    LibintSigned *result = NULL;
+    LibintUnsigned *quotient = NULL;
+    if (!libint || !out || !x) {
+        err = LIBINT_ERROR_BAD_ARGUMENT;
+        goto end;
+    }
+    *out = NULL;
+    err = E(allocate(libint, &result));
+    if (err) goto end;
+    uintmax_t r;
+    if (y == (LibintWord) y) {
+        // Divides a copy in place, so that the result takes a single allocation.
+        err = E(libint_unsigned_copy_into(libint, &result->magnitude, &x->magnitude));
+        if (err) goto end;
+        LibintUnsigned *magnitude = &result->magnitude;
+        LibintWord word_remainder;
+        err = E(libint_unsigned_div_mod_word_replace(libint, &magnitude, y, &word_remainder));
+        if (err) goto end;
+        r = word_remainder;
+    } else {
+        err = E(libint_unsigned_div_mod_ui(libint, &quotient, &x->magnitude, y, &r));
+        if (err) goto end;
+        libint_unsigned_move(&result->magnitude, quotient);
+    }
+    result->is_negative = x->is_negative;
+    if (x->is_negative && r) {
+        // The quotient is rounded down, so that the remainder is not negative.
+        LibintUnsigned one;
+        libint_unsigned_set_uintmax(&one, 1);
+        err = E(libint_unsigned_add_into(libint, &result->magnitude, &result->magnitude, &one));
+        if (err) goto end;
+        r = y - r;
+    }
+    normalize(result);
+    assert(LIBINT_SIGNED_INVARIANT(result));
+    if (remainder) {
+        *remainder = r;
+    }
+    *out = result;
+    result = NULL;
+end:
+    E(libint_destroy(libint, &result));
+    E(libint_unsigned_destroy(libint, &quotient));
+    return err;
+}
+
+LibintError libint_add_si_replace(Libint *libint, LibintSigned **x, intmax_t y) {
+    if (!libint || !x) {
+        return LIBINT_ERROR_BAD_ARGUMENT;
+    }
+    LibintSigned operand;
+    set_scalar(&operand, y < 0, magnitude_of(y));
+    return E(add_into(libint, *x, *x, &operand, false));
+}
+
+LibintError libint_sub_si_replace(Libint *libint, LibintSigned **x, intmax_t y) {
+    if (!libint || !x) {
+        return LIBINT_ERROR_BAD_ARGUMENT;
+    }
+    LibintSigned operand;
+    set_scalar(&operand, y > 0, magnitude_of(y));
+    return E(add_into(libint, *x, *x, &operand, false));
+}
+
+LibintError libint_mul_si_replace(Libint *libint, LibintSigned **x, intmax_t y) {
+    if (!libint || !x) {
+        return LIBINT_ERROR_BAD_ARGUMENT;
+    }
+    LibintSigned operand;
+    set_scalar(&operand, y < 0, magnitude_of(y));
+    return E(libint_mul_into(libint, *x, *x, &operand));
+}
+
+LibintError libint_compare_si(Libint *libint, LibintSigned *x, intmax_t y, int *order) {
+    if (!libint || !x || !order) {
+        return LIBINT_ERROR_BAD_ARGUMENT;
+    }
+    LibintSigned operand;
+    set_scalar(&operand, y < 0, magnitude_of(y));
+    return E(libint_compare(libint, x, &operand, order));
+}
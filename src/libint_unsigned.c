@@ -2,66 +2,39 @@
 
 #include <assert.h>
 #include <limits.h>
-#include <math.h>
 #include <string.h>
 #include <stdio.h>
 #include <ctype.h>
 
 LibintError libint_unsigned_create(Libint *libint, LibintUnsigned **x, uintmax_t value) {
     LibintError err = LIBINT_ERROR_OK;
-    LibintWord *ptr = NULL;
-    void *new_ptr = NULL;
     if (!libint || !x) {
         err = LIBINT_ERROR_BAD_ARGUMENT;
         goto end;
     }
-    *x = NULL;
-    size_t size = (sizeof(uintmax_t) + sizeof(LibintWord) - 1) / sizeof(LibintWord);
-    ptr = malloc(sizeof(LibintWord) * size);
-    if (!ptr) {
-        err = LIBINT_ERROR_OUT_OF_MEMORY;
-        goto end;
-    }
-    size_t i = 0;
-    do {
-        ptr[i] = value;
-        value >>= sizeof(LibintWord) * CHAR_BIT;
-        ++i;
-    } while (i < size && value);
-    size = i;
-    new_ptr = realloc(ptr, sizeof(LibintWord) * size);
-    if (!new_ptr) {
-        err = LIBINT_ERROR_OUT_OF_MEMORY;
-        goto end;
-    }
-    ptr = new_ptr;
-    new_ptr = NULL;
-    err = E(libint_unsigned_construct(libint, x, size, ptr));
+    err = E(libint_unsigned_allocate(libint, x));
     if (err) goto end;
-    ptr = NULL;
+    libint_unsigned_set_uintmax(*x, value);
 end:
-    free(ptr);
-    free(new_ptr);
     return err;
 }
 
 LibintError libint_unsigned_to_uintmax(Libint *libint, LibintUnsigned *x, uintmax_t *value) {
     LibintError err = LIBINT_ERROR_OK;
-    size_t msb;
     if (!libint || !x || !value) {
         err = LIBINT_ERROR_BAD_ARGUMENT;
         goto end;
     }
     *value = 0;
-    err = E(libint_unsigned_most_significant_bit(libint, x, &msb));
-    if (err) goto end;
-    if (msb > sizeof(uintmax_t) * CHAR_BIT) {
+    if (x->size > (sizeof(uintmax_t) + sizeof(LibintWord) - 1) / sizeof(LibintWord)) {
         err = LIBINT_ERROR_ARITHMETIC;
         goto end;
     }
     uintmax_t result = 0;
     for (size_t i = x->size; i--;) {
-        result <<= sizeof(LibintWord) * CHAR_BIT;
+        // Two shifts, because a word may be as wide as uintmax_t.
+        result <<= LIBINT_WORD_BITS / 2;
+        result <<= LIBINT_WORD_BITS / 2;
         result += x->ptr[i];
     }
     *value = result;
@@ -95,47 +68,158 @@ static bool parse_digit(char c, int base, int *digit) {
     return true;
 }
 
+// Parses size valid digits, a word-sized chunk of them at a time.
+static LibintError from_string_basecase(Libint *libint, LibintUnsigned **x, const char *digits, size_t size, int base) {
+    LibintError err = LIBINT_ERROR_OK;
+    LibintWord *ptr = NULL;
+    size_t exponent;
+    LibintWord radix = libint_radix_word(base, &exponent);
+    ptr = libint_malloc(libint, sizeof(LibintWord) * (size / exponent + 1));
+    if (!ptr) {
+        err = LIBINT_ERROR_OUT_OF_MEMORY;
+        goto end;
+    }
+    size_t ptr_size = 0;
+    // The first chunk is shorter, so that all the others have exactly exponent digits.
+    size_t chunk_size = size % exponent ? size % exponent : exponent;
+    for (const char *it = digits; it != digits + size; it += chunk_size, chunk_size = exponent) {
+        LibintWord chunk = 0;
+        for (size_t i = 0; i < chunk_size; ++i) {
+            int digit;
+            hex_char_to_int(it[i], &digit);
+            chunk = chunk * (LibintWord) base + (LibintWord) digit;
+        }
+        // ptr = ptr * radix + chunk
+        LibintWord carry = chunk;
+        for (size_t i = 0; i < ptr_size; ++i) {
+            LibintDword t = (LibintDword) ptr[i] * radix + carry;
+            ptr[i] = (LibintWord) t;
+            carry = (LibintWord) (t >> LIBINT_WORD_BITS);
+        }
+        if (carry) {
+            ptr[ptr_size++] = carry;
+        }
+    }
+    if (!ptr_size) {
+        ptr[ptr_size++] = 0;
+    }
+    err = E(libint_unsigned_construct(libint, x, ptr_size, ptr));
+    if (err) goto end;
+    ptr = NULL;
+end:
+    libint_free(libint, ptr);
+    return err;
+}
+
+// Same as from_string_basecase, but splits long input in two and combines the halves by the cached powers of base.
+static LibintError from_string_recursive(
+        Libint *libint, LibintUnsigned **x, const char *digits, size_t size, int base) {
+    LibintError err = LIBINT_ERROR_OK;
+    LibintUnsigned *high = NULL;
+    LibintUnsigned *low = NULL;
+    size_t exponent;
+    libint_radix_word(base, &exponent);
+    if (size / exponent < libint->from_string_recursive_threshold) {
+        err = E(from_string_basecase(libint, x, digits, size, base));
+        if (err) goto end;
+        goto end;
+    }
+    // The low part has exponent * 2^i digits, at most half of them.
+    size_t i = 0;
+    while ((exponent << (i + 1)) * 2 <= size) {
+        ++i;
+    }
+    size_t low_size = exponent << i;
+    LibintUnsigned *power;
+    err = E(libint_radix_power(libint, base, i, &power));
+    if (err) goto end;
+    err = E(from_string_recursive(libint, &high, digits, size - low_size, base));
+    if (err) goto end;
+    err = E(from_string_recursive(libint, &low, digits + size - low_size, low_size, base));
+    if (err) goto end;
+    err = E(libint_unsigned_mul_replace(libint, &high, power));
+    if (err) goto end;
+    err = E(libint_unsigned_add_replace(libint, &high, low));
+    if (err) goto end;
+    *x = high;
+    high = NULL;
+end:
+    E(libint_unsigned_destroy(libint, &high));
+    E(libint_unsigned_destroy(libint, &low));
+    return err;
+}
+
+// Number of bits in a digit if base is a power of two, 0 otherwise.
+static unsigned digit_bits(int base) {
+    if (base & (base - 1)) {
+        return 0;
+    }
+    unsigned bits = 0;
+    while ((1 << bits) < base) {
+        ++bits;
+    }
+    return bits;
+}
+
+// Parses size valid digits in a base of 2^bits by copying their bits straight into the words.
+static LibintError from_string_power_of_two(
+        Libint *libint, LibintUnsigned **x, const char *digits, size_t size, unsigned bits) {
+    LibintError err = LIBINT_ERROR_OK;
+    LibintWord *ptr = NULL;
+    size_t ptr_size = (size * bits + LIBINT_WORD_BITS - 1) / LIBINT_WORD_BITS;
+    if (!ptr_size) {
+        ptr_size = 1;
+    }
+    ptr = libint_malloc(libint, sizeof(LibintWord) * ptr_size);
+    if (!ptr) {
+        err = LIBINT_ERROR_OUT_OF_MEMORY;
+        goto end;
+    }
+    memset(ptr, 0, sizeof(LibintWord) * ptr_size);
+    size_t position = 0;
+    for (size_t i = size; i--; position += bits) {
+        int digit;
+        hex_char_to_int(digits[i], &digit);
+        size_t word = position / LIBINT_WORD_BITS;
+        unsigned offset = position % LIBINT_WORD_BITS;
+        ptr[word] |= (LibintWord) digit << offset;
+        if (offset + bits > LIBINT_WORD_BITS) {
+            ptr[word + 1] |= (LibintWord) digit >> (LIBINT_WORD_BITS - offset);
+        }
+    }
+    ptr_size = libint_words_normalized_size(ptr, ptr_size);
+    err = E(libint_unsigned_construct(libint, x, ptr_size, ptr));
+    if (err) goto end;
+    ptr = NULL;
+end:
+    libint_free(libint, ptr);
+    return err;
+}
+
 LibintError libint_unsigned_from_string(
         Libint *libint, LibintUnsigned **x, const char *input, size_t input_size, int base, const char **input_end) {
     LibintError err = LIBINT_ERROR_OK;
-    LibintUnsigned *result = NULL;
-    LibintUnsigned *base_long = NULL;
     const char *current = input;
-    size_t bytes_left = input_size;
     if (!libint || !x || !input || base < 2 || 16 < base || !input_end) {
         err = LIBINT_ERROR_BAD_ARGUMENT;
         goto end;
     }
     *input_end = NULL;
     *x = NULL;
-    err = E(libint_unsigned_create(libint, &result, 0));
-    if (err) goto end;
-    err = E(libint_unsigned_create(libint, &base_long, base));
-    if (err) goto end;
-    char c = (char) (bytes_left ? *current : '\0');
-    while (true) {
-        int digit = -1;
-        if (!parse_digit(c, base, &digit)) {
-            break;
-        }
-        err = E(libint_unsigned_mul_replace(libint, &result, base_long));
+    int digit;
+    while (current != input + input_size && parse_digit(*current, base, &digit)) {
+        ++current;
+    }
+    unsigned bits = digit_bits(base);
+    if (bits) {
+        err = E(from_string_power_of_two(libint, x, input, (size_t) (current - input), bits));
         if (err) goto end;
-        err = E(libint_unsigned_add_replace(libint, &result, libint->libint_unsigned_constants[digit]));
+    } else {
+        err = E(from_string_recursive(libint, x, input, (size_t) (current - input), base));
         if (err) goto end;
-        if (bytes_left) {
-            ++current;
-            --bytes_left;
-            c = *current;
-        } else {
-            c = '\0';
-        }
     }
-    *x = result;
-    result = NULL;
 end:
     if (input_end) *input_end = current;
-    E(libint_unsigned_destroy(libint, &base_long));
-    E(libint_unsigned_destroy(libint, &result));
     return err;
 }
 
@@ -151,15 +235,252 @@ end:
     return err;
 }
 
-LibintError
-libint_to_string_helper(Libint *libint, bool is_negative, LibintUnsigned *x, int base, char **out, size_t *out_size) {
-    // expansion_factor[i] = ceil(8 * log(2) / log(i + 2))
-    static size_t expansion_factor[] = { 8, 6, 4, 4, 4, 3, 3, 3, 3, 3, 3, 3, 3, 3, 2 };
+LibintWord libint_radix_word(int base, size_t *exponent) {
+    LibintWord result = (LibintWord) base;
+    size_t k = 1;
+    while (result <= (LibintWord) -1 / (LibintWord) base) {
+        result *= (LibintWord) base;
+        ++k;
+    }
+    *exponent = k;
+    return result;
+}
+
+LibintError libint_radix_power(Libint *libint, int base, size_t i, LibintUnsigned **power) {
+    LibintError err = LIBINT_ERROR_OK;
+    LibintUnsigned *next = NULL;
+    bool is_suspended = false;
+    if (!libint || base < 2 || 16 < base || !power) {
+        err = LIBINT_ERROR_BAD_ARGUMENT;
+        goto end;
+    }
+    *power = NULL;
+    // The cache outlives the arena.
+    ++libint->arena_suspended;
+    is_suspended = true;
+    while (libint->radix_power_counts[base] <= i) {
+        size_t count = libint->radix_power_counts[base];
+        LibintUnsigned **powers =
+                libint_realloc(libint, libint->radix_powers[base], sizeof(LibintUnsigned *) * (count + 1));
+        if (!powers) {
+            err = LIBINT_ERROR_OUT_OF_MEMORY;
+            goto end;
+        }
+        libint->radix_powers[base] = powers;
+        LibintDivider **dividers =
+                libint_realloc(libint, libint->radix_dividers[base], sizeof(LibintDivider *) * (count + 1));
+        if (!dividers) {
+            err = LIBINT_ERROR_OUT_OF_MEMORY;
+            goto end;
+        }
+        libint->radix_dividers[base] = dividers;
+        if (count) {
+            err = E(libint_unsigned_sqr(libint, &next, powers[count - 1]));
+            if (err) goto end;
+        } else {
+            size_t exponent;
+            err = E(libint_unsigned_create(libint, &next, libint_radix_word(base, &exponent)));
+            if (err) goto end;
+        }
+        powers[count] = next;
+        dividers[count] = NULL;
+        next = NULL;
+        libint->radix_power_counts[base] = count + 1;
+    }
+    *power = libint->radix_powers[base][i];
+end:
+    E(libint_unsigned_destroy(libint, &next));
+    if (is_suspended) {
+        --libint->arena_suspended;
+    }
+    return err;
+}
+
+LibintError libint_radix_divider(Libint *libint, int base, size_t i, LibintDivider **divider) {
+    LibintError err = LIBINT_ERROR_OK;
+    if (!libint || !divider) {
+        err = LIBINT_ERROR_BAD_ARGUMENT;
+        goto end;
+    }
+    *divider = NULL;
+    LibintUnsigned *power;
+    err = E(libint_radix_power(libint, base, i, &power));
+    if (err) goto end;
+    if (!libint->radix_dividers[base][i]) {
+        ++libint->arena_suspended;
+        err = E(libint_divider_create(libint, &libint->radix_dividers[base][i], power));
+        --libint->arena_suspended;
+        if (err) goto end;
+    }
+    *divider = libint->radix_dividers[base][i];
+end:
+    return err;
+}
+
+void libint_radix_powers_destroy(Libint *libint) {
+    for (int base = 0; base < 17; ++base) {
+        for (size_t i = 0; i < libint->radix_power_counts[base]; ++i) {
+            E(libint_unsigned_destroy(libint, &libint->radix_powers[base][i]));
+            E(libint_divider_destroy(libint, &libint->radix_dividers[base][i]));
+        }
+        libint_free(libint, libint->radix_powers[base]);
+        libint_free(libint, libint->radix_dividers[base]);
+        libint->radix_powers[base] = NULL;
+        libint->radix_dividers[base] = NULL;
+        libint->radix_power_counts[base] = 0;
+    }
+}
+
+// Writes x to out, padded with zeros to width digits unless width is 0, and stores the number of digits into
+// *size. Every division by the biggest power of base that fits into a word gives a chunk of digits.
+static LibintError to_string_basecase(
+        Libint *libint, LibintUnsigned *x, int base, size_t width, char *out, size_t *size) {
     const char *digits = "0123456789ABCDEF";
     LibintError err = LIBINT_ERROR_OK;
-    LibintUnsigned *dividend = NULL;
+    LibintWord *dividend = NULL;
+    size_t exponent;
+    LibintWord radix = libint_radix_word(base, &exponent);
+    // A chunk takes more than half of a word.
+    dividend = libint_malloc(libint, sizeof(LibintWord) * (x->size + 2 * x->size + 1));
+    if (!dividend) {
+        err = LIBINT_ERROR_OUT_OF_MEMORY;
+        goto end;
+    }
+    LibintWord *chunks = dividend + x->size;
+    memcpy(dividend, x->ptr, sizeof(LibintWord) * x->size);
+    size_t dividend_size = x->size;
+    LibintWordReciprocal reciprocal;
+    libint_words_reciprocal(&reciprocal, radix);
+    size_t chunk_count = 0;
+    do {
+        chunks[chunk_count++] = libint_words_div_word_reciprocal(dividend, dividend, dividend_size, &reciprocal);
+        dividend_size = libint_words_normalized_size(dividend, dividend_size);
+    } while (dividend_size > 1 || dividend[0]);
+    char top[LIBINT_WORD_BITS];
+    size_t top_size = 0;
+    LibintWord chunk = chunks[chunk_count - 1];
+    do {
+        top[top_size++] = digits[chunk % (LibintWord) base];
+        chunk /= (LibintWord) base;
+    } while (chunk);
+    size_t digit_count = top_size + (chunk_count - 1) * exponent;
+    char *it = out;
+    if (width) {
+        assert(digit_count <= width);
+        memset(it, '0', width - digit_count);
+        it += width - digit_count;
+    }
+    while (top_size) {
+        *it++ = top[--top_size];
+    }
+    for (size_t i = chunk_count - 1; i--;) {
+        chunk = chunks[i];
+        for (size_t j = exponent; j--;) {
+            it[j] = digits[chunk % (LibintWord) base];
+            chunk /= (LibintWord) base;
+        }
+        it += exponent;
+    }
+    *size = (size_t) (it - out);
+end:
+    libint_free(libint, dividend);
+    return err;
+}
+
+// Same as to_string_basecase, but splits long x into halves by the cached powers of base.
+static LibintError to_string_recursive(
+        Libint *libint, LibintUnsigned *x, int base, size_t width, char *out, size_t *size) {
+    LibintError err = LIBINT_ERROR_OK;
     LibintUnsigned *quotient = NULL;
     LibintUnsigned *remainder = NULL;
+    if (x->size < libint->to_string_recursive_threshold) {
+        err = E(to_string_basecase(libint, x, base, width, out, size));
+        if (err) goto end;
+        goto end;
+    }
+    // The biggest power that is at most half as long as x.
+    size_t i = 0;
+    LibintUnsigned *power;
+    err = E(libint_radix_power(libint, base, i, &power));
+    if (err) goto end;
+    while (power->size * 4 <= x->size) {
+        err = E(libint_radix_power(libint, base, ++i, &power));
+        if (err) goto end;
+    }
+    size_t exponent;
+    libint_radix_word(base, &exponent);
+    size_t low_width = exponent << i;
+    LibintDivider *divider;
+    err = E(libint_radix_divider(libint, base, i, &divider));
+    if (err) goto end;
+    err = E(libint_divider_div_mod(libint, &quotient, &remainder, x, divider));
+    if (err) goto end;
+    size_t high_size;
+    assert(!width || width > low_width);
+    err = E(to_string_recursive(libint, quotient, base, width ? width - low_width : 0, out, &high_size));
+    if (err) goto end;
+    size_t low_size;
+    err = E(to_string_recursive(libint, remainder, base, low_width, out + high_size, &low_size));
+    if (err) goto end;
+    *size = high_size + low_size;
+end:
+    E(libint_unsigned_destroy(libint, &quotient));
+    E(libint_unsigned_destroy(libint, &remainder));
+    return err;
+}
+
+// Converts x to string in a base of 2^bits by reading the bits of every digit straight from the words. The output is
+// allocated once and exactly.
+static LibintError to_string_power_of_two(
+        Libint *libint, bool is_negative, LibintUnsigned *x, unsigned bits, char **out, size_t *out_size) {
+    const char *digits = "0123456789ABCDEF";
+    LibintError err = LIBINT_ERROR_OK;
+    char *result = NULL;
+    bool is_zero;
+    err = E(libint_unsigned_is_zero(libint, x, &is_zero));
+    if (err) goto end;
+    size_t digit_count = 1;
+    if (!is_zero) {
+        size_t msb;
+        err = E(libint_unsigned_most_significant_bit(libint, x, &msb));
+        if (err) goto end;
+        digit_count = msb / bits + 1;
+    }
+    size_t result_size = (is_negative ? 1 : 0) + digit_count;
+    result = malloc(result_size + 1);
+    if (!result) {
+        err = LIBINT_ERROR_OUT_OF_MEMORY;
+        goto end;
+    }
+    char *it = result;
+    if (is_negative) {
+        *it++ = '-';
+    }
+    LibintWord mask = ((LibintWord) 1 << bits) - 1;
+    for (size_t i = digit_count; i--;) {
+        size_t position = i * bits;
+        size_t word = position / LIBINT_WORD_BITS;
+        unsigned offset = position % LIBINT_WORD_BITS;
+        LibintWord digit = x->ptr[word] >> offset;
+        if (offset + bits > LIBINT_WORD_BITS && word + 1 < x->size) {
+            digit |= x->ptr[word + 1] << (LIBINT_WORD_BITS - offset);
+        }
+        *it++ = digits[digit & mask];
+    }
+    *it = '\0';
+    *out_size = result_size;
+    *out = result;
+    result = NULL;
+end:
+    free(result);
+    return err;
+}
+
+LibintError
+libint_to_string_helper(Libint *libint, bool is_negative, LibintUnsigned *x, int base, char **out, size_t *out_size) {
+    // expansion_factor[i] = ceil(8 * log(2) / log(i + 2)) digits per byte, which holds for words of any size.
+    static size_t expansion_factor[] = { 8, 6, 4, 4, 4, 3, 3, 3, 3, 3, 3, 3, 3, 3, 2 };
+    LibintError err = LIBINT_ERROR_OK;
     char *result = NULL;
     char *result_shrinked = NULL;
     if (!libint || !x || !out || !out_size || base < 2 || 16 < base) {
@@ -168,6 +489,12 @@ libint_to_string_helper(Libint *libint, bool is_negative, LibintUnsigned *x, int
     }
     *out = NULL;
     *out_size = 0;
+    unsigned bits = digit_bits(base);
+    if (bits) {
+        err = E(to_string_power_of_two(libint, is_negative, x, bits, out, out_size));
+        if (err) goto end;
+        goto end;
+    }
     size_t result_size = 0;
     if (is_negative) {
         result_size += 1; // '-'
@@ -179,34 +506,15 @@ libint_to_string_helper(Libint *libint, bool is_negative, LibintUnsigned *x, int
         err = LIBINT_ERROR_OUT_OF_MEMORY;
         goto end;
     }
-    err = E(libint_unsigned_copy(libint, &dividend, x));
-    if (err) goto end;
     char *it = result;
-    int is_not_zero = true;
-    while (is_not_zero) {
-        err = E(libint_unsigned_div_mod(libint, &quotient, &remainder, dividend,
-                                        libint->libint_unsigned_constants[base]));
-        if (err) goto end;
-        LibintWord digit = remainder->ptr[0];
-        assert(remainder->size == 1);
-        assert((int) digit < base);
-        *it++ = digits[digit];
-        E(libint_unsigned_destroy(libint, &dividend));
-        E(libint_unsigned_destroy(libint, &remainder));
-        dividend = quotient;
-        err = E(libint_unsigned_compare(libint, libint->libint_unsigned_constants[0], dividend, &is_not_zero));
-        if (err) goto end;
-    }
-    E(libint_unsigned_destroy(libint, &dividend));
     if (is_negative) {
         *it++ = '-';
     }
+    size_t digit_count;
+    err = E(to_string_recursive(libint, x, base, 0, it, &digit_count));
+    if (err) goto end;
+    it += digit_count;
     size_t result_real_size = it - result;
-    for (size_t i = 0; i < result_real_size / 2; ++i) {
-        char t = result[i];
-        result[i] = result[result_real_size - 1 - i];
-        result[result_real_size - 1 - i] = t;
-    }
     *it = '\0';
     result_shrinked = realloc(result, result_real_size + 1);
     if (!result_shrinked) {
@@ -217,11 +525,99 @@ libint_to_string_helper(Libint *libint, bool is_negative, LibintUnsigned *x, int
     result_shrinked = NULL;
     result = NULL;
 end:
-    E(libint_unsigned_destroy(libint, &dividend));
-    E(libint_unsigned_destroy(libint, &remainder));
     free(result);
     free(result_shrinked);
-    free(dividend);
+    return err;
+}
+
+void libint_unsigned_init(LibintUnsigned *x) {
+    x->size = 1;
+    x->capacity = LIBINT_INLINE_WORDS;
+    x->ptr = x->inline_words;
+    x->references = NULL;
+    x->outside_arena = false;
+    x->ptr[0] = 0;
+}
+
+// Zero that keeps the placement of x.
+static void reinit(LibintUnsigned *x) {
+    bool outside_arena = x->outside_arena;
+    libint_unsigned_init(x);
+    x->outside_arena = outside_arena;
+}
+
+void libint_unsigned_release(Libint *libint, LibintUnsigned *x) {
+    if (x->references && atomic_fetch_sub(x->references, 1) > 1) {
+        // Other numbers still use the buffer.
+        reinit(x);
+        return;
+    }
+    libint_free(libint, x->references);
+    if (x->ptr != x->inline_words) {
+        libint_free(libint, x->ptr);
+    }
+    reinit(x);
+}
+
+void libint_unsigned_move(LibintUnsigned *to, LibintUnsigned *from) {
+    bool outside_arena = to->outside_arena;
+    *to = *from;
+    to->outside_arena = outside_arena;
+    if (from->ptr == from->inline_words) {
+        to->ptr = to->inline_words;
+    }
+    reinit(from);
+}
+
+// Memory for x, see outside_arena.
+static void *allocate_for(Libint *libint, LibintUnsigned *x, size_t size) {
+    libint->arena_suspended += x->outside_arena;
+    void *ptr = libint_malloc(libint, size);
+    libint->arena_suspended -= x->outside_arena;
+    return ptr;
+}
+
+void libint_unsigned_set_uintmax(LibintUnsigned *x, uintmax_t value) {
+    x->capacity = LIBINT_INLINE_WORDS;
+    x->ptr = x->inline_words;
+    x->references = NULL;
+    size_t i = 0;
+    do {
+        x->ptr[i] = value;
+        // Two shifts, because a word may be as wide as uintmax_t.
+        value >>= LIBINT_WORD_BITS / 2;
+        value >>= LIBINT_WORD_BITS / 2;
+        ++i;
+    } while (value);
+    x->size = i;
+    assert(LIBINT_UNSIGNED_INVARIANT(x));
+}
+
+bool libint_unsigned_is_reduced(const LibintUnsigned *x, const LibintUnsigned *modulus) {
+    return x->size < modulus->size ||
+           (x->size == modulus->size && libint_words_compare(x->ptr, modulus->ptr, x->size) < 0);
+}
+
+void libint_unsigned_pad(LibintWord *out, const LibintUnsigned *x, size_t size) {
+    assert(x->size <= size);
+    memcpy(out, x->ptr, sizeof(LibintWord) * x->size);
+    memset(out + x->size, 0, sizeof(LibintWord) * (size - x->size));
+}
+
+LibintError libint_unsigned_allocate(Libint *libint, LibintUnsigned **x) {
+    LibintError err = LIBINT_ERROR_OK;
+    if (!libint || !x) {
+        err = LIBINT_ERROR_BAD_ARGUMENT;
+        goto end;
+    }
+    *x = libint_malloc(libint, sizeof(LibintUnsigned));
+    if (!*x) {
+        err = LIBINT_ERROR_OUT_OF_MEMORY;
+        goto end;
+    }
+    libint_unsigned_init(*x);
+    (*x)->outside_arena = libint_outside_arena(libint);
+end:
     return err;
 }
 
@@ -232,30 +628,147 @@ LibintError libint_unsigned_construct(Libint *libint, LibintUnsigned **x, size_t
         err = LIBINT_ERROR_BAD_ARGUMENT;
         goto end;
     }
-    out = malloc(sizeof(LibintUnsigned));
+    out = libint_malloc(libint, sizeof(LibintUnsigned));
     if (!out) {
         err = LIBINT_ERROR_OUT_OF_MEMORY;
         goto end;
     }
     out->size = size;
+    out->capacity = size;
     out->ptr = ptr;
+    out->references = NULL;
+    out->outside_arena = libint_outside_arena(libint);
     assert(LIBINT_UNSIGNED_INVARIANT(out));
     *x = out;
     out = NULL;
 end:
-    free(out);
+    libint_free(libint, out);
+    return err;
+}
+
+LibintError libint_unsigned_share(Libint *libint, LibintUnsigned *out, LibintUnsigned *x) {
+    LibintError err = LIBINT_ERROR_OK;
+    if (!libint || !out || !x) {
+        err = LIBINT_ERROR_BAD_ARGUMENT;
+        goto end;
+    }
+    // A number outside of an arena may not share memory with one inside, which is freed by its reset.
+    if (x->ptr == x->inline_words || out->outside_arena != x->outside_arena) {
+        err = E(libint_unsigned_copy_into(libint, out, x));
+        if (err) goto end;
+        goto end;
+    }
+    if (!x->references) {
+        // The count lives as long as the buffer, so it is placed with it.
+        x->references = allocate_for(libint, x, sizeof(*x->references));
+        if (!x->references) {
+            err = LIBINT_ERROR_OUT_OF_MEMORY;
+            goto end;
+        }
+        atomic_init(x->references, 1);
+    }
+    atomic_fetch_add(x->references, 1);
+    bool outside_arena = out->outside_arena;
+    *out = *x;
+    out->outside_arena = outside_arena;
+end:
+    return err;
+}
+
+// Gives x a buffer of its own if it shares one.
+static LibintError unshare(Libint *libint, LibintUnsigned *x) {
+    LibintError err = LIBINT_ERROR_OK;
+    if (!x->references) {
+        goto end;
+    }
+    if (atomic_load(x->references) > 1) {
+        LibintWord *ptr = allocate_for(libint, x, sizeof(LibintWord) * x->capacity);
+        if (!ptr) {
+            err = LIBINT_ERROR_OUT_OF_MEMORY;
+            goto end;
+        }
+        memcpy(ptr, x->ptr, sizeof(LibintWord) * x->size);
+        if (atomic_fetch_sub(x->references, 1) == 1) {
+            // The other numbers were released by other threads while copying.
+            libint_free(libint, x->references);
+            libint_free(libint, x->ptr);
+        }
+        x->ptr = ptr;
+    } else {
+        libint_free(libint, x->references);
+    }
+    x->references = NULL;
+end:
+    return err;
+}
+
+LibintError libint_unsigned_reserve(Libint *libint, LibintUnsigned *x, size_t capacity) {
+    LibintError err = LIBINT_ERROR_OK;
+    if (!libint || !x) {
+        err = LIBINT_ERROR_BAD_ARGUMENT;
+        goto end;
+    }
+    err = E(unshare(libint, x));
+    if (err) goto end;
+    if (capacity <= x->capacity) {
+        goto end;
+    }
+    if (capacity < x->capacity * 2) {
+        capacity = x->capacity * 2;
+    }
+    LibintWord *ptr;
+    if (x->ptr == x->inline_words) {
+        ptr = allocate_for(libint, x, sizeof(LibintWord) * capacity);
+        if (!ptr) {
+            err = LIBINT_ERROR_OUT_OF_MEMORY;
+            goto end;
+        }
+        memcpy(ptr, x->inline_words, sizeof(LibintWord) * x->size);
+    } else {
+        ptr = libint_realloc(libint, x->ptr, sizeof(LibintWord) * capacity);
+        if (!ptr) {
+            err = LIBINT_ERROR_OUT_OF_MEMORY;
+            goto end;
+        }
+    }
+    x->ptr = ptr;
+    x->capacity = capacity;
+end:
     return err;
 }
 
 LibintError libint_unsigned_copy(Libint *libint, LibintUnsigned **out, LibintUnsigned *x) {
     LibintError err = LIBINT_ERROR_OK;
+    LibintUnsigned *result = NULL;
     if (!libint || !out || !x) {
         err = LIBINT_ERROR_BAD_ARGUMENT;
         goto end;
     }
     *out = NULL;
-    err = E(libint_unsigned_add(libint, out, libint->libint_unsigned_constants[0], x));
+    err = E(libint_unsigned_allocate(libint, &result));
+    if (err) goto end;
+    err = E(libint_unsigned_share(libint, result, x));
+    if (err) goto end;
+    *out = result;
+    result = NULL;
+end:
+    E(libint_unsigned_destroy(libint, &result));
+    return err;
+}
+
+LibintError libint_unsigned_copy_into(Libint *libint, LibintUnsigned *out, LibintUnsigned *x) {
+    LibintError err = LIBINT_ERROR_OK;
+    if (!libint || !out || !x) {
+        err = LIBINT_ERROR_BAD_ARGUMENT;
+        goto end;
+    }
+    if (out == x) {
+        goto end;
+    }
+    err = E(libint_unsigned_reserve(libint, out, x->size));
     if (err) goto end;
+    memcpy(out->ptr, x->ptr, sizeof(LibintWord) * x->size);
+    out->size = x->size;
 end:
     return err;
 }
@@ -267,8 +780,8 @@ LibintError libint_unsigned_destroy(Libint *libint, LibintUnsigned **x) {
         goto end;
     }
     if (*x) {
-        free((*x)->ptr);
-        free(*x);
+        libint_unsigned_release(libint, *x);
+        libint_free(libint, *x);
         *x = NULL;
     }
 end:
@@ -277,7 +790,25 @@ end:
 
 LibintError libint_unsigned_add(Libint *libint, LibintUnsigned **out, LibintUnsigned *x, LibintUnsigned *y) {
     LibintError err = LIBINT_ERROR_OK;
-    LibintWord *out_ptr = NULL;
+    LibintUnsigned *result = NULL;
+    if (!libint || !out || !x || !y) {
+        err = LIBINT_ERROR_BAD_ARGUMENT;
+        goto end;
+    }
+    *out = NULL;
+    err = E(libint_unsigned_allocate(libint, &result));
+    if (err) goto end;
+    err = E(libint_unsigned_add_into(libint, result, x, y));
+    if (err) goto end;
+    *out = result;
+    result = NULL;
+end:
+    E(libint_unsigned_destroy(libint, &result));
+    return err;
+}
+
+LibintError libint_unsigned_add_into(Libint *libint, LibintUnsigned *out, LibintUnsigned *x, LibintUnsigned *y) {
+    LibintError err = LIBINT_ERROR_OK;
     if (!libint || !out || !x || !y) {
         err = LIBINT_ERROR_BAD_ARGUMENT;
         goto end;
@@ -287,54 +818,43 @@ LibintError libint_unsigned_add(Libint *libint, LibintUnsigned **out, LibintUnsi
         x = y;
         y = t;
     }
-    *out = NULL;
-    size_t out_size = x->size;
-    out_ptr = malloc(sizeof(LibintWord) * out_size);
-    if (!out_ptr) {
-        err = LIBINT_ERROR_OUT_OF_MEMORY;
-        goto end;
-    }
-    LibintWord *x_it = x->ptr;
-    LibintWord *x_end = x->ptr + x->size;
-    LibintWord *y_it = y->ptr;
-    LibintWord *y_end = y->ptr + y->size;
-    LibintWord *it = out_ptr;
-    LibintWord carry = 0;
-    while (x_it != x_end) {
-        LibintDword a = *x_it++;
-        LibintDword b = y_it < y_end ? *y_it++ : 0;
-        LibintDword c = a + b + carry;
-        *it = c;
-        carry = c >> (sizeof(LibintWord) * CHAR_BIT);
-        ++it;
-    }
+    err = E(libint_unsigned_reserve(libint, out, x->size + 1));
+    if (err) goto end;
+    LibintWord carry = libint_words_add(out->ptr, x->ptr, x->size, y->ptr, y->size);
+    out->size = x->size;
     if (carry) {
-        ++out_size;
-        LibintWord *out_ptr_new = realloc(out_ptr, sizeof(LibintWord) * out_size);
-        if (!out_ptr_new) {
-            err = LIBINT_ERROR_OUT_OF_MEMORY;
-            goto end;
-        }
-        out_ptr = out_ptr_new;
-        out_ptr[out_size - 1] = carry;
+        out->ptr[out->size++] = carry;
     }
-    err = E(libint_unsigned_construct(libint, out, out_size, out_ptr));
-    if (err) goto end;
-    out_ptr = NULL;
+    assert(LIBINT_UNSIGNED_INVARIANT(out));
 end:
-    free(out_ptr);
     return err;
 }
 
 LibintError libint_unsigned_sub(Libint *libint, LibintUnsigned **out, LibintUnsigned *x, LibintUnsigned *y) {
     LibintError err = LIBINT_ERROR_OK;
-    LibintWord *out_ptr = NULL;
-    void *new_ptr = NULL;
+    LibintUnsigned *result = NULL;
     if (!libint || !out || !x || !y) {
         err = LIBINT_ERROR_BAD_ARGUMENT;
         goto end;
     }
     *out = NULL;
+    err = E(libint_unsigned_allocate(libint, &result));
+    if (err) goto end;
+    err = E(libint_unsigned_sub_into(libint, result, x, y));
+    if (err) goto end;
+    *out = result;
+    result = NULL;
+end:
+    E(libint_unsigned_destroy(libint, &result));
+    return err;
+}
+
+LibintError libint_unsigned_sub_into(Libint *libint, LibintUnsigned *out, LibintUnsigned *x, LibintUnsigned *y) {
+    LibintError err = LIBINT_ERROR_OK;
+    if (!libint || !out || !x || !y) {
+        err = LIBINT_ERROR_BAD_ARGUMENT;
+        goto end;
+    }
     int order;
     err = E(libint_unsigned_compare(libint, x, y, &order));
     if (err) goto end;
@@ -342,54 +862,15 @@ LibintError libint_unsigned_sub(Libint *libint, LibintUnsigned **out, LibintUnsi
         err = LIBINT_ERROR_ARITHMETIC;
         goto end;
     }
-    size_t out_size = x->size > y->size ? x->size : y->size;
-    out_ptr = malloc(sizeof(LibintWord) * out_size);
-    if (!out_ptr) {
-        err = LIBINT_ERROR_OUT_OF_MEMORY;
-        goto end;
-    }
-    LibintWord *out_it = out_ptr;
-    LibintWord *x_it = x->ptr;
-    LibintWord *y_it = y->ptr;
-    LibintWord *x_end = x->ptr + x->size;
-    LibintWord *y_end = y->ptr + y->size;
-    bool borrow = false;
-    while (y_it != y_end) {
-        LibintWord a = *x_it;
-        LibintWord b = *y_it;
-        *out_it = a - (b + borrow);
-        borrow = a < b + borrow;
-        ++x_it;
-        ++y_it;
-        ++out_it;
-    }
-    while (x_it != x_end) {
-        LibintWord a = *x_it;
-        *out_it = a - borrow;
-        borrow = a < borrow;
-        ++x_it;
-        ++out_it;
-    }
-    assert(out_size);
-    LibintWord *most_significant_word = out_ptr + out_size - 1;
-    while (most_significant_word != out_ptr && !*most_significant_word) {
-        --most_significant_word;
-    }
-    out_size = most_significant_word - out_ptr + 1;
-    new_ptr = realloc(out_ptr, sizeof(LibintWord) * out_size);
-    if (!new_ptr) {
-        err = LIBINT_ERROR_OUT_OF_MEMORY;
-        goto end;
-    }
-    out_ptr = new_ptr;
-    new_ptr = NULL;
-    err = E(libint_unsigned_construct(libint, out, out_size, out_ptr));
+    err = E(libint_unsigned_reserve(libint, out, x->size));
     if (err) goto end;
-    out_ptr = NULL;
+    LibintWord borrow = libint_words_sub(out->ptr, x->ptr, x->size, y->ptr, y->size);
+    assert(!borrow);
+    (void) borrow;
+    out->size = libint_words_normalized_size(out->ptr, x->size);
+    assert(LIBINT_UNSIGNED_INVARIANT(out));
 end:
-    free(out_ptr);
-    free(new_ptr);
-    return LIBINT_ERROR_OK;
+    return err;
 }
 
 LibintError libint_unsigned_most_significant_bit(Libint *libint, LibintUnsigned *x, size_t *msb) {
@@ -406,53 +887,191 @@ LibintError libint_unsigned_most_significant_bit(Libint *libint, LibintUnsigned
         err = LIBINT_ERROR_ARITHMETIC;
         goto end;
     }
-    LibintWord most_significand_word = x->ptr[x->size - 1];
-    assert(most_significand_word);
-    for (size_t i = sizeof(LibintWord) * CHAR_BIT; i--;) {
-        if (most_significand_word & (((LibintWord) 1) << i)) {
-            *msb = i + (x->size - 1) * sizeof(LibintWord) * CHAR_BIT;
-            break;
+    *msb = x->size * LIBINT_WORD_BITS - 1 - libint_words_leading_zeros(x->ptr[x->size - 1]);
+end:
+    return err;
+}
+
+LibintError libint_unsigned_wordshift(Libint *libint, LibintUnsigned **out, LibintUnsigned *x, int offset) {
+    LibintError err = LIBINT_ERROR_OK;
+    LibintWord *result_ptr = NULL;
+    if (!libint || !out || !x) {
+        err = LIBINT_ERROR_BAD_ARGUMENT;
+        goto end;
+    }
+    *out = NULL;
+    size_t result_size;
+    if (offset >= 0) {
+        result_ptr = libint_malloc(libint, (x->size + offset) * sizeof(LibintWord));
+        if (!result_ptr) {
+            err = LIBINT_ERROR_OUT_OF_MEMORY;
+            goto end;
         }
+        memcpy(result_ptr + offset, x->ptr, x->size * sizeof(LibintWord));
+        memset(result_ptr, 0, offset * sizeof(LibintWord));
+    } else if (offset < 0) {
+        result_ptr = libint_malloc(libint, (x->size + offset) * sizeof(LibintWord));
+        if (!result_ptr) {
+            err = LIBINT_ERROR_OUT_OF_MEMORY;
+            goto end;
+        }
+        memcpy(result_ptr, x->ptr - offset, (x->size + offset) * sizeof(LibintWord));
+    }
+    result_size = x->size + offset;
+    err = E(libint_unsigned_construct(libint, out, result_size, result_ptr));
+    if (err) goto end;
+    result_ptr = NULL;
+end:
+    libint_free(libint, result_ptr);
+    return err;
+}
+
+// out = x << offset, or x >> -offset if offset is negative. Shifts in a single pass straight from x into out, so
+// out is allocated at most once and may be x.
+static LibintError bitshift_into(Libint *libint, LibintUnsigned *out, LibintUnsigned *x, int offset) {
+    LibintError err = LIBINT_ERROR_OK;
+    if (offset >= 0) {
+        size_t words = (size_t) offset / LIBINT_WORD_BITS;
+        unsigned bits = (unsigned) offset % LIBINT_WORD_BITS;
+        size_t size = x->size;
+        err = E(libint_unsigned_reserve(libint, out, size + words + 1));
+        if (err) goto end;
+        // Goes from the top, so the words of x are read before they are overwritten when out is x.
+        if (bits) {
+            out->ptr[size + words] = libint_words_lshift(out->ptr + words, x->ptr, size, bits);
+        } else {
+            memmove(out->ptr + words, x->ptr, sizeof(LibintWord) * size);
+            out->ptr[size + words] = 0;
+        }
+        memset(out->ptr, 0, sizeof(LibintWord) * words);
+        out->size = libint_words_normalized_size(out->ptr, size + words + 1);
+    } else {
+        size_t shift = (size_t) -(long long) offset;
+        size_t words = shift / LIBINT_WORD_BITS;
+        unsigned bits = shift % LIBINT_WORD_BITS;
+        if (words >= x->size) {
+            err = E(libint_unsigned_reserve(libint, out, 1));
+            if (err) goto end;
+            out->ptr[0] = 0;
+            out->size = 1;
+            goto end;
+        }
+        size_t size = x->size - words;
+        err = E(libint_unsigned_reserve(libint, out, size));
+        if (err) goto end;
+        if (bits) {
+            libint_words_rshift(out->ptr, x->ptr + words, size, bits);
+        } else {
+            memmove(out->ptr, x->ptr + words, sizeof(LibintWord) * size);
+        }
+        out->size = libint_words_normalized_size(out->ptr, size);
+    }
+    assert(LIBINT_UNSIGNED_INVARIANT(out));
+end:
+    return err;
+}
+
+LibintError libint_unsigned_bitshift(Libint *libint, LibintUnsigned **out, LibintUnsigned *x, int offset) {
+    LibintError err = LIBINT_ERROR_OK;
+    LibintUnsigned *result = NULL;
+    if (!libint || !out || !x) {
+        err = LIBINT_ERROR_BAD_ARGUMENT;
+        goto end;
+    }
+    *out = NULL;
+    if (!offset) {
+        err = E(libint_unsigned_copy(libint, out, x));
+        goto end;
+    }
+    err = E(libint_unsigned_allocate(libint, &result));
+    if (err) goto end;
+    err = E(bitshift_into(libint, result, x, offset));
+    if (err) goto end;
+    *out = result;
+    result = NULL;
+end:
+    E(libint_unsigned_destroy(libint, &result));
+    return err;
+}
+
+LibintError libint_unsigned_mul(Libint *libint, LibintUnsigned **out, LibintUnsigned *x, LibintUnsigned *y) {
+    LibintError err = LIBINT_ERROR_OK;
+    LibintUnsigned *result = NULL;
+    if (!libint || !out || !x || !y) {
+        err = LIBINT_ERROR_BAD_ARGUMENT;
+        goto end;
+    }
+    *out = NULL;
+    err = E(libint_unsigned_allocate(libint, &result));
+    if (err) goto end;
+    err = E(libint_unsigned_mul_into(libint, result, x, y));
+    if (err) goto end;
+    *out = result;
+    result = NULL;
+end:
+    E(libint_unsigned_destroy(libint, &result));
+    return err;
+}
+
+LibintError libint_unsigned_mul_into(Libint *libint, LibintUnsigned *out, LibintUnsigned *x, LibintUnsigned *y) {
+    LibintError err = LIBINT_ERROR_OK;
+    LibintUnsigned result;
+    libint_unsigned_init(&result);
+    LibintWord *scratch = NULL;
+    if (!libint || !out || !x || !y) {
+        err = LIBINT_ERROR_BAD_ARGUMENT;
+        goto end;
+    }
+    if (x == y) {
+        err = E(libint_unsigned_sqr_into(libint, out, x));
+        goto end;
+    }
+    if (x->size < y->size) {
+        LibintUnsigned *t = y;
+        y = x;
+        x = t;
+    }
+    if (y->size == 1) {
+        // Multiplication by a word works in place, so out may be x or y.
+        LibintWord word = y->ptr[0];
+        err = E(libint_unsigned_reserve(libint, out, x->size + 1));
+        if (err) goto end;
+        out->ptr[x->size] = libint_words_mul_word(out->ptr, x->ptr, x->size, word);
+        out->size = libint_words_normalized_size(out->ptr, x->size + 1);
+        assert(LIBINT_UNSIGNED_INVARIANT(out));
+        goto end;
     }
-end:
-    return err;
-}
-
-LibintError libint_unsigned_wordshift(Libint *libint, LibintUnsigned **out, LibintUnsigned *x, int offset) {
-    LibintError err = LIBINT_ERROR_OK;
-    LibintWord *result_ptr = NULL;
-    if (!libint || !out || !x) {
-        err = LIBINT_ERROR_BAD_ARGUMENT;
+    if (out == x || out == y) {
+        result.outside_arena = out->outside_arena;
+        err = E(libint_unsigned_mul_into(libint, &result, x, y));
+        if (err) goto end;
+        libint_unsigned_release(libint, out);
+        libint_unsigned_move(out, &result);
         goto end;
     }
-    *out = NULL;
-    size_t result_size;
-    if (offset >= 0) {
-        result_ptr = malloc((x->size + offset) * sizeof(LibintWord));
-        if (!result_ptr) {
-            err = LIBINT_ERROR_OUT_OF_MEMORY;
-            goto end;
-        }
-        memcpy(result_ptr + offset, x->ptr, x->size * sizeof(LibintWord));
-        memset(result_ptr, 0, offset * sizeof(LibintWord));
-    } else if (offset < 0) {
-        result_ptr = malloc((x->size + offset) * sizeof(LibintWord));
-        if (!result_ptr) {
+    size_t out_size = x->size + y->size;
+    err = E(libint_unsigned_reserve(libint, out, out_size));
+    if (err) goto end;
+    err = E(libint_words_mul_prepare(libint, x->size));
+    if (err) goto end;
+    size_t scratch_size = libint_words_mul_scratch_size(libint, x->size);
+    if (scratch_size) {
+        scratch = libint_malloc(libint, sizeof(LibintWord) * scratch_size);
+        if (!scratch) {
             err = LIBINT_ERROR_OUT_OF_MEMORY;
             goto end;
         }
-        memcpy(result_ptr, x->ptr - offset, (x->size + offset) * sizeof(LibintWord));
     }
-    result_size = x->size + offset;
-    err = E(libint_unsigned_construct(libint, out, result_size, result_ptr));
-    if (err) goto end;
-    result_ptr = NULL;
+    libint_words_mul(libint, out->ptr, x->ptr, x->size, y->ptr, y->size, scratch);
+    out->size = libint_words_normalized_size(out->ptr, out_size);
+    assert(LIBINT_UNSIGNED_INVARIANT(out));
 end:
-    free(result_ptr);
+    libint_unsigned_release(libint, &result);
+    libint_free(libint, scratch);
     return err;
 }
 
-LibintError libint_unsigned_bitshift(Libint *libint, LibintUnsigned **out, LibintUnsigned *x, int offset) {
+LibintError libint_unsigned_sqr(Libint *libint, LibintUnsigned **out, LibintUnsigned *x) {
     LibintError err = LIBINT_ERROR_OK;
     LibintUnsigned *result = NULL;
     if (!libint || !out || !x) {
@@ -460,42 +1079,10 @@ LibintError libint_unsigned_bitshift(Libint *libint, LibintUnsigned **out, Libin
         goto end;
     }
     *out = NULL;
-    bool is_zero;
-    err = E(libint_unsigned_is_zero(libint, x, &is_zero));
-    if (err) goto end;
-    if (is_zero || !offset) {
-        err = E(libint_unsigned_copy(libint, out, x));
-        goto end;
-    }
-    size_t msb = 0;
-    err = E(libint_unsigned_most_significant_bit(libint, x, &msb));
+    err = E(libint_unsigned_allocate(libint, &result));
     if (err) goto end;
-    if ((int) msb + offset < 0) {
-        err = E(libint_unsigned_copy(libint, out, libint->libint_unsigned_constants[0]));
-        goto end;
-    }
-    size_t word_size_in_bits = sizeof(LibintWord) * CHAR_BIT;
-    int word_offset = floor((double) (offset + (int) msb % (int) word_size_in_bits) / word_size_in_bits);
-    err = E(libint_unsigned_wordshift(libint, &result, x, word_offset));
+    err = E(libint_unsigned_sqr_into(libint, result, x));
     if (err) goto end;
-    int remaining_offset = offset - word_offset * (int) word_size_in_bits;
-    assert(0 <= abs(remaining_offset) && abs(remaining_offset) < (int) word_size_in_bits);
-    if (remaining_offset < 0) {
-        for (size_t i = 0; i < result->size; ++i) {
-            LibintDword hi = (i + 1 < result->size) ? result->ptr[i + 1] : 0;
-            LibintDword lo = result->ptr[i];
-            LibintDword dword = (hi << word_size_in_bits) | lo;
-            result->ptr[i] = dword >> -remaining_offset;
-        }
-    } else if (0 < remaining_offset) {
-        for (size_t i = result->size; i--;) {
-            LibintDword hi = result->ptr[i];
-            LibintDword lo = i ? result->ptr[i - 1] : 0;
-            LibintDword dword = (hi << word_size_in_bits) | lo;
-            result->ptr[i] = dword >> (word_size_in_bits - remaining_offset);
-        }
-    }
-    assert(LIBINT_UNSIGNED_INVARIANT(result));
     *out = result;
     result = NULL;
 end:
@@ -503,94 +1090,158 @@ end:
     return err;
 }
 
-LibintError libint_unsigned_mul(Libint *libint, LibintUnsigned **out, LibintUnsigned *x, LibintUnsigned *y) {
+LibintError libint_unsigned_sqr_into(Libint *libint, LibintUnsigned *out, LibintUnsigned *x) {
     LibintError err = LIBINT_ERROR_OK;
-    LibintUnsigned *result = NULL;
-    LibintUnsigned *addend = NULL;
-    if (!libint || !out || !x || !y) {
+    LibintUnsigned result;
+    libint_unsigned_init(&result);
+    LibintWord *scratch = NULL;
+    if (!libint || !out || !x) {
         err = LIBINT_ERROR_BAD_ARGUMENT;
         goto end;
     }
-    *out = NULL;
-    if (x->size < y->size) {
-        LibintUnsigned *t = y;
-        y = x;
-        x = t;
+    if (out == x) {
+        result.outside_arena = out->outside_arena;
+        err = E(libint_unsigned_sqr_into(libint, &result, x));
+        if (err) goto end;
+        libint_unsigned_release(libint, out);
+        libint_unsigned_move(out, &result);
+        goto end;
     }
-    err = E(libint_unsigned_create(libint, &result, 0));
+    size_t out_size = 2 * x->size;
+    err = E(libint_unsigned_reserve(libint, out, out_size));
     if (err) goto end;
-    err = E(libint_unsigned_copy(libint, &addend, x));
+    err = E(libint_words_mul_prepare(libint, x->size));
     if (err) goto end;
-    // TODO current implementation is bitwise. it may be much faster if made wordwise.
-    for (LibintWord *it = y->ptr, *end = y->ptr + y->size; it != end; ++it) {
-        LibintWord word = *it;
-        for (LibintWord bit = 0; bit < (LibintWord) sizeof(LibintWord) * CHAR_BIT; ++bit) {
-            if (word & (((LibintWord) 1) << bit)) {
-                err = E(libint_unsigned_add_replace(libint, &result, addend));
-                if (err) goto end;
-            }
-            err = E(libint_unsigned_bitshift_replace(libint, &addend, 1));
-            if (err) goto end;
+    size_t scratch_size = libint_words_sqr_scratch_size(libint, x->size);
+    if (scratch_size) {
+        scratch = libint_malloc(libint, sizeof(LibintWord) * scratch_size);
+        if (!scratch) {
+            err = LIBINT_ERROR_OUT_OF_MEMORY;
+            goto end;
         }
     }
-    *out = result;
-    result = NULL;
+    libint_words_sqr(libint, out->ptr, x->ptr, x->size, scratch);
+    out->size = libint_words_normalized_size(out->ptr, out_size);
+    assert(LIBINT_UNSIGNED_INVARIANT(out));
 end:
-    E(libint_unsigned_destroy(libint, &addend));
-    E(libint_unsigned_destroy(libint, &result));
+    libint_unsigned_release(libint, &result);
+    libint_free(libint, scratch);
     return err;
 }
 
 LibintError libint_unsigned_div_mod(Libint *libint, LibintUnsigned **out, LibintUnsigned **remainder, LibintUnsigned *x,
                                     LibintUnsigned *y) {
     LibintError err = LIBINT_ERROR_OK;
-    LibintUnsigned *window = NULL;
-    LibintUnsigned *quotient = NULL;
-    if (!libint || !out || !x || !y) {
+    LibintUnsigned *result_quotient = NULL;
+    LibintUnsigned *result_remainder = NULL;
+    if (!libint || !out || !remainder || !x || !y) {
         err = LIBINT_ERROR_BAD_ARGUMENT;
         goto end;
     }
     *out = NULL;
     *remainder = NULL;
-    int order;
-    err = E(libint_unsigned_compare(libint, y, libint->libint_unsigned_constants[0], &order));
+    err = E(libint_unsigned_allocate(libint, &result_quotient));
+    if (err) goto end;
+    err = E(libint_unsigned_allocate(libint, &result_remainder));
     if (err) goto end;
-    if (order == 0) {
+    err = E(libint_unsigned_div_mod_into(libint, result_quotient, result_remainder, x, y));
+    if (err) goto end;
+    *out = result_quotient;
+    result_quotient = NULL;
+    *remainder = result_remainder;
+    result_remainder = NULL;
+end:
+    E(libint_unsigned_destroy(libint, &result_quotient));
+    E(libint_unsigned_destroy(libint, &result_remainder));
+    return err;
+}
+
+LibintError libint_unsigned_div_mod_into(
+        Libint *libint, LibintUnsigned *quotient, LibintUnsigned *remainder, LibintUnsigned *x, LibintUnsigned *y) {
+    LibintError err = LIBINT_ERROR_OK;
+    LibintUnsigned quotient_result;
+    LibintUnsigned remainder_result;
+    libint_unsigned_init(&quotient_result);
+    libint_unsigned_init(&remainder_result);
+    LibintWord *scratch = NULL;
+    if (!libint || !x || !y) {
+        err = LIBINT_ERROR_BAD_ARGUMENT;
+        goto end;
+    }
+    if (y->size == 1 && !y->ptr[0]) {
         err = LIBINT_ERROR_ARITHMETIC;
         goto end;
     }
-    err = E(libint_unsigned_create(libint, &window, 0));
-    if (err) goto end;
-    err = E(libint_unsigned_create(libint, &quotient, 0));
-    if (err) goto end;
-    for (LibintWord *x_rit = x->ptr + x->size, *x_rend = x->ptr; x_rit-- != x_rend;) {
-        LibintWord word = *x_rit;
-        for (size_t bit = sizeof(LibintWord) * CHAR_BIT; bit--;) {
-            err = E(libint_unsigned_bitshift_replace(libint, &window, 1));
-            if (err) goto end;
-            if (word & (((LibintWord) 1) << bit)) {
-                err = E(libint_unsigned_add_replace(libint, &window, libint->libint_unsigned_constants[1]));
-                if (err) goto end;
-            }
-            err = E(libint_unsigned_bitshift_replace(libint, &quotient, 1));
+    if (quotient == x || quotient == y || remainder == x || remainder == y) {
+        // The words of the operands may not be overwritten while they are divided.
+        quotient_result.outside_arena = quotient && quotient->outside_arena;
+        remainder_result.outside_arena = remainder && remainder->outside_arena;
+        err = E(libint_unsigned_div_mod_into(
+                libint, quotient ? &quotient_result : NULL, remainder ? &remainder_result : NULL, x, y));
+        if (err) goto end;
+        if (quotient) {
+            libint_unsigned_release(libint, quotient);
+            libint_unsigned_move(quotient, &quotient_result);
+        }
+        if (remainder) {
+            libint_unsigned_release(libint, remainder);
+            libint_unsigned_move(remainder, &remainder_result);
+        }
+        goto end;
+    }
+    if (x->size < y->size) {
+        if (remainder) {
+            err = E(libint_unsigned_copy_into(libint, remainder, x));
             if (err) goto end;
-            err = E(libint_unsigned_compare(libint, window, y, &order));
+        }
+        if (quotient) {
+            err = E(libint_unsigned_reserve(libint, quotient, 1));
             if (err) goto end;
-            if (order >= 0) {
-                err = E(libint_unsigned_sub_replace(libint, &window, y));
-                if (err) goto end;
-                err = E(libint_unsigned_add_replace(libint, &quotient, libint->libint_unsigned_constants[1]));
-                if (err) goto end;
-            }
+            quotient->ptr[0] = 0;
+            quotient->size = 1;
+        }
+        goto end;
+    }
+    size_t quotient_size = x->size - y->size + 1;
+    size_t remainder_size = y->size;
+    size_t div_scratch_size = 0;
+    if (y->size > 1) {
+        err = E(libint_words_mul_prepare(libint, y->size + 1));
+        if (err) goto end;
+        div_scratch_size = libint_words_div_mod_scratch_size(libint, x->size, y->size);
+    }
+    // A result that is not needed is a part of the scratch.
+    size_t scratch_size = div_scratch_size + (quotient ? 0 : quotient_size) + (remainder ? 0 : remainder_size);
+    if (quotient) {
+        err = E(libint_unsigned_reserve(libint, quotient, quotient_size));
+        if (err) goto end;
+    }
+    if (remainder) {
+        err = E(libint_unsigned_reserve(libint, remainder, remainder_size));
+        if (err) goto end;
+    }
+    if (scratch_size) {
+        scratch = libint_malloc(libint, sizeof(LibintWord) * scratch_size);
+        if (!scratch) {
+            err = LIBINT_ERROR_OUT_OF_MEMORY;
+            goto end;
         }
     }
-    *out = quotient;
-    *remainder = window;
-    quotient = NULL;
-    window = NULL;
+    LibintWord *q = quotient ? quotient->ptr : scratch + div_scratch_size;
+    LibintWord *r = remainder ? remainder->ptr : scratch + scratch_size - remainder_size;
+    libint_words_div_mod(libint, q, r, x->ptr, x->size, y->ptr, y->size, scratch);
+    if (quotient) {
+        quotient->size = libint_words_normalized_size(q, quotient_size);
+        assert(LIBINT_UNSIGNED_INVARIANT(quotient));
+    }
+    if (remainder) {
+        remainder->size = libint_words_normalized_size(r, remainder_size);
+        assert(LIBINT_UNSIGNED_INVARIANT(remainder));
+    }
 end:
-    E(libint_unsigned_destroy(libint, &quotient));
-    E(libint_unsigned_destroy(libint, &window));
+    libint_unsigned_release(libint, &quotient_result);
+    libint_unsigned_release(libint, &remainder_result);
+    libint_free(libint, scratch);
     return err;
 }
 
@@ -622,6 +1273,66 @@ end:
     return err;
 }
 
+LibintError libint_unsigned_div_into(Libint *libint, LibintUnsigned *out, LibintUnsigned *x, LibintUnsigned *y) {
+    LibintError err = LIBINT_ERROR_OK;
+    if (!libint || !out || !x || !y) {
+        err = LIBINT_ERROR_BAD_ARGUMENT;
+        goto end;
+    }
+    if (y->size == 1 && y->ptr[0]) {
+        // Division by a word works in place, so out may be x or y.
+        LibintWord word = y->ptr[0];
+        err = E(libint_unsigned_copy_into(libint, out, x));
+        if (err) goto end;
+        err = E(libint_unsigned_reserve(libint, out, out->size));
+        if (err) goto end;
+        libint_words_div_word(out->ptr, out->ptr, out->size, word);
+        out->size = libint_words_normalized_size(out->ptr, out->size);
+        assert(LIBINT_UNSIGNED_INVARIANT(out));
+        goto end;
+    }
+    err = E(libint_unsigned_div_mod_into(libint, out, NULL, x, y));
+end:
+    return err;
+}
+
+LibintError libint_unsigned_mod_into(Libint *libint, LibintUnsigned *out, LibintUnsigned *x, LibintUnsigned *y) {
+    if (!libint || !out || !x || !y) {
+        return LIBINT_ERROR_BAD_ARGUMENT;
+    }
+    return E(libint_unsigned_div_mod_into(libint, NULL, out, x, y));
+}
+
+LibintError libint_unsigned_div_mod_word(
+        Libint *libint, LibintUnsigned **out, LibintUnsigned *x, LibintWord y, LibintWord *remainder) {
+    LibintError err = LIBINT_ERROR_OK;
+    LibintWord *ptr = NULL;
+    if (!libint || !out || !x) {
+        err = LIBINT_ERROR_BAD_ARGUMENT;
+        goto end;
+    }
+    *out = NULL;
+    if (!y) {
+        err = LIBINT_ERROR_ARITHMETIC;
+        goto end;
+    }
+    ptr = libint_malloc(libint, sizeof(LibintWord) * x->size);
+    if (!ptr) {
+        err = LIBINT_ERROR_OUT_OF_MEMORY;
+        goto end;
+    }
+    LibintWord r = libint_words_div_word(ptr, x->ptr, x->size, y);
+    err = E(libint_unsigned_construct(libint, out, libint_words_normalized_size(ptr, x->size), ptr));
+    if (err) goto end;
+    ptr = NULL;
+    if (remainder) {
+        *remainder = r;
+    }
+end:
+    libint_free(libint, ptr);
+    return err;
+}
+
 LibintError libint_unsigned_pow(Libint *libint, LibintUnsigned **out, LibintUnsigned *x, uintmax_t power) {
     LibintError err = LIBINT_ERROR_OK;
     LibintUnsigned *result = NULL;
@@ -644,9 +1355,11 @@ LibintError libint_unsigned_pow(Libint *libint, LibintUnsigned **out, LibintUnsi
             err = E(libint_unsigned_mul_replace(libint, &result, base));
             if (err) goto end;
         }
-        err = E(libint_unsigned_mul_replace(libint, &base, base));
-        if (err) goto end;
         power /= 2;
+        if (power) {
+            err = E(libint_unsigned_sqr_replace(libint, &base));
+            if (err) goto end;
+        }
     }
     *out = result;
     result = NULL;
@@ -658,113 +1371,140 @@ end:
 
 LibintError libint_unsigned_add_replace(Libint *libint, LibintUnsigned **x, LibintUnsigned *y) {
     LibintError err = LIBINT_ERROR_OK;
-    LibintUnsigned *result = NULL;
     if (!libint || !x || !y) {
         err = LIBINT_ERROR_BAD_ARGUMENT;
         goto end;
     }
-    err = E(libint_unsigned_add(libint, &result, *x, y));
-    if (err) {
-        return err;
+    LibintUnsigned *a = *x;
+    size_t size = a->size > y->size ? a->size : y->size;
+    err = E(libint_unsigned_reserve(libint, a, size + 1));
+    if (err) goto end;
+    if (a->size < size) {
+        memset(a->ptr + a->size, 0, sizeof(LibintWord) * (size - a->size));
+        a->size = size;
+    }
+    LibintWord carry = libint_words_add(a->ptr, a->ptr, a->size, y->ptr, y->size);
+    if (carry) {
+        a->ptr[a->size++] = carry;
     }
-    E(libint_unsigned_destroy(libint, x));
-    *x = result;
+    assert(LIBINT_UNSIGNED_INVARIANT(a));
 end:
     return err;
 }
 
 LibintError libint_unsigned_sub_replace(Libint *libint, LibintUnsigned **x, LibintUnsigned *y) {
     LibintError err = LIBINT_ERROR_OK;
-    LibintUnsigned *result = NULL;
     if (!libint || !x || !y) {
         err = LIBINT_ERROR_BAD_ARGUMENT;
         goto end;
     }
-    err = E(libint_unsigned_sub(libint, &result, *x, y));
+    LibintUnsigned *a = *x;
+    int order;
+    err = E(libint_unsigned_compare(libint, a, y, &order));
+    if (err) goto end;
+    if (order < 0) {
+        err = LIBINT_ERROR_ARITHMETIC;
+        goto end;
+    }
+    err = E(libint_unsigned_reserve(libint, a, a->size));
     if (err) goto end;
-    E(libint_unsigned_destroy(libint, x));
-    *x = result;
+    LibintWord borrow = libint_words_sub(a->ptr, a->ptr, a->size, y->ptr, y->size);
+    assert(!borrow);
+    (void) borrow;
+    a->size = libint_words_normalized_size(a->ptr, a->size);
+    assert(LIBINT_UNSIGNED_INVARIANT(a));
 end:
     return err;
 }
 
 LibintError libint_unsigned_rsub_replace(Libint *libint, LibintUnsigned **x, LibintUnsigned *y) {
-    LibintError err = LIBINT_ERROR_OK;
-    LibintUnsigned *result = NULL;
     if (!libint || !x || !y) {
-        err = LIBINT_ERROR_BAD_ARGUMENT;
-        goto end;
+        return LIBINT_ERROR_BAD_ARGUMENT;
     }
-    LibintUnsigned *a = y;
-    LibintUnsigned *b = *x;
-    err = E(libint_unsigned_add(libint, &result, a, b));
-    if (err) goto end;
-    E(libint_unsigned_destroy(libint, x));
-    *x = result;
-end:
-    return err;
+    return E(libint_unsigned_add_into(libint, *x, y, *x));
 }
 
 LibintError libint_unsigned_bitshift_replace(Libint *libint, LibintUnsigned **x, int offset) {
     LibintError err = LIBINT_ERROR_OK;
-    LibintUnsigned *result = NULL;
     if (!libint || !x) {
         err = LIBINT_ERROR_BAD_ARGUMENT;
         goto end;
     }
-    err = E(libint_unsigned_bitshift(libint, &result, *x, offset));
+    err = E(bitshift_into(libint, *x, *x, offset));
     if (err) goto end;
-    E(libint_unsigned_destroy(libint, x));
-    *x = result;
 end:
     return err;
 }
 
 LibintError libint_unsigned_mul_replace(Libint *libint, LibintUnsigned **x, LibintUnsigned *y) {
-    LibintError err = LIBINT_ERROR_OK;
-    LibintUnsigned *result = NULL;
     if (!libint || !x || !y) {
+        return LIBINT_ERROR_BAD_ARGUMENT;
+    }
+    return E(libint_unsigned_mul_into(libint, *x, *x, y));
+}
+
+LibintError libint_unsigned_mul_word_replace(Libint *libint, LibintUnsigned **x, LibintWord y) {
+    LibintError err = LIBINT_ERROR_OK;
+    if (!libint || !x) {
         err = LIBINT_ERROR_BAD_ARGUMENT;
         goto end;
     }
-    err = E(libint_unsigned_mul(libint, &result, *x, y));
+    LibintUnsigned *a = *x;
+    err = E(libint_unsigned_reserve(libint, a, a->size + 1));
     if (err) goto end;
-    E(libint_unsigned_destroy(libint, x));
-    *x = result;
+    LibintWord carry = libint_words_mul_word(a->ptr, a->ptr, a->size, y);
+    if (carry) {
+        a->ptr[a->size++] = carry;
+    }
+    a->size = libint_words_normalized_size(a->ptr, a->size);
+    assert(LIBINT_UNSIGNED_INVARIANT(a));
 end:
     return err;
 }
 
+LibintError libint_unsigned_sqr_replace(Libint *libint, LibintUnsigned **x) {
+    if (!libint || !x) {
+        return LIBINT_ERROR_BAD_ARGUMENT;
+    }
+    return E(libint_unsigned_sqr_into(libint, *x, *x));
+}
+
 LibintError libint_unsigned_div_replace(Libint *libint, LibintUnsigned **x, LibintUnsigned *y) {
-    LibintError err = LIBINT_ERROR_OK;
-    LibintUnsigned *result = NULL;
     if (!libint || !x || !y) {
+        return LIBINT_ERROR_BAD_ARGUMENT;
+    }
+    return E(libint_unsigned_div_into(libint, *x, *x, y));
+}
+
+LibintError libint_unsigned_div_mod_word_replace(
+        Libint *libint, LibintUnsigned **x, LibintWord y, LibintWord *remainder) {
+    LibintError err = LIBINT_ERROR_OK;
+    if (!libint || !x) {
         err = LIBINT_ERROR_BAD_ARGUMENT;
         goto end;
     }
-    err = E(libint_unsigned_div(libint, &result, *x, y));
+    if (!y) {
+        err = LIBINT_ERROR_ARITHMETIC;
+        goto end;
+    }
+    LibintUnsigned *a = *x;
+    err = E(libint_unsigned_reserve(libint, a, a->size));
     if (err) goto end;
-    E(libint_unsigned_destroy(libint, x));
-    *x = result;
+    LibintWord r = libint_words_div_word(a->ptr, a->ptr, a->size, y);
+    a->size = libint_words_normalized_size(a->ptr, a->size);
+    assert(LIBINT_UNSIGNED_INVARIANT(a));
+    if (remainder) {
+        *remainder = r;
+    }
 end:
     return err;
 }
 
 LibintError libint_unsigned_rdiv_replace(Libint *libint, LibintUnsigned **x, LibintUnsigned *y) {
-    LibintError err = LIBINT_ERROR_OK;
-    LibintUnsigned *result = NULL;
     if (!libint || !x || !y) {
-        err = LIBINT_ERROR_BAD_ARGUMENT;
-        goto end;
+        return LIBINT_ERROR_BAD_ARGUMENT;
     }
-    LibintUnsigned *a = y;
-    LibintUnsigned *b = *x;
-    err = E(libint_unsigned_div(libint, &result, a, b));
-    if (err) goto end;
-    E(libint_unsigned_destroy(libint, x));
-    *x = result;
-end:
-    return err;
+    return E(libint_unsigned_div_into(libint, *x, y, *x));
 }
 
 LibintError libint_unsigned_pow_replace(Libint *libint, LibintUnsigned **x, uintmax_t power) {
@@ -776,9 +1516,11 @@ LibintError libint_unsigned_pow_replace(Libint *libint, LibintUnsigned **x, uint
     }
     err = E(libint_unsigned_pow(libint, &result, *x, power));
     if (err) goto end;
-    E(libint_unsigned_destroy(libint, x));
-    *x = result;
+    // Copied rather than swapped, so that *x keeps its place outside of an arena.
+    err = E(libint_unsigned_copy_into(libint, *x, result));
+    if (err) goto end;
 end:
+    E(libint_unsigned_destroy(libint, &result));
     return err;
 }
 
@@ -808,22 +1550,7 @@ LibintError libint_unsigned_compare(Libint *libint, LibintUnsigned *x, LibintUns
         *order = 1;
         goto end;
     }
-    *order = 0;
-    for (LibintWord *x_rit = x->ptr + x->size,
-                 *x_rend = x->ptr,
-                 *y_rit = y->ptr + y->size;
-         --y_rit, x_rit-- != x_rend;) {
-        LibintWord a = *x_rit;
-        LibintWord b = *y_rit;
-        if (a < b) {
-            *order = -1;
-            break;
-        }
-        if (a > b) {
-            *order = 1;
-            break;
-        }
-    }
+    *order = libint_words_compare(x->ptr, y->ptr, x->size);
 end:
     return err;
 }
@@ -857,3 +1584,128 @@ LibintError libint_unsigned_less_or_equal(Libint *libint, LibintUnsigned *x, Lib
 end:
     return LIBINT_ERROR_OK;
 }
+
+LibintError libint_unsigned_add_ui(Libint *libint, LibintUnsigned **out, LibintUnsigned *x, uintmax_t y) {
+    if (!libint || !out || !x) {
+        return LIBINT_ERROR_BAD_ARGUMENT;
+    }
+    LibintUnsigned operand;
+    libint_unsigned_set_uintmax(&operand, y);
+    return E(libint_unsigned_add(libint, out, x, &operand));
+}
+
+LibintError libint_unsigned_sub_ui(Libint *libint, LibintUnsigned **out, LibintUnsigned *x, uintmax_t y) {
+    if (!libint || !out || !x) {
+        return LIBINT_ERROR_BAD_ARGUMENT;
+    }
+    LibintUnsigned operand;
+    libint_unsigned_set_uintmax(&operand, y);
+    return E(libint_unsigned_sub(libint, out, x, &operand));
+}
+
+LibintError libint_unsigned_mul_ui(Libint *libint, LibintUnsigned **out, LibintUnsigned *x, uintmax_t y) {
+    if (!libint || !out || !x) {
+        return LIBINT_ERROR_BAD_ARGUMENT;
+    }
+    LibintUnsigned operand;
+    libint_unsigned_set_uintmax(&operand, y);
+    return E(libint_unsigned_mul(libint, out, x, &operand));
+}
+
+LibintError libint_unsigned_div_mod_ui(
+        Libint *libint, LibintUnsigned **out, LibintUnsigned *x, uintmax_t y, uintmax_t *remainder) {
+    LibintError err = LIBINT_ERROR_OK;
+    LibintUnsigned *result_remainder = NULL;
+    if (!libint || !out || !x) {
+        err = LIBINT_ERROR_BAD_ARGUMENT;
+        goto end;
+    }
+    *out = NULL;
+    if (y == (LibintWord) y) {
+        LibintWord r;
+        err = E(libint_unsigned_div_mod_word(libint, out, x, y, &r));
+        if (err) goto end;
+        if (remainder) {
+            *remainder = r;
+        }
+        goto end;
+    }
+    LibintUnsigned operand;
+    libint_unsigned_set_uintmax(&operand, y);
+    err = E(libint_unsigned_div_mod(libint, out, &result_remainder, x, &operand));
+    if (err) goto end;
+    if (remainder) {
+        err = E(libint_unsigned_to_uintmax(libint, result_remainder, remainder));
+        if (err) goto end;
+    }
+end:
+    E(libint_unsigned_destroy(libint, &result_remainder));
+    return err;
+}
+
+LibintError libint_unsigned_add_ui_replace(Libint *libint, LibintUnsigned **x, uintmax_t y) {
+    if (!libint || !x) {
+        return LIBINT_ERROR_BAD_ARGUMENT;
+    }
+    LibintUnsigned operand;
+    libint_unsigned_set_uintmax(&operand, y);
+    return E(libint_unsigned_add_replace(libint, x, &operand));
+}
+
+LibintError libint_unsigned_sub_ui_replace(Libint *libint, LibintUnsigned **x, uintmax_t y) {
+    if (!libint || !x) {
+        return LIBINT_ERROR_BAD_ARGUMENT;
+    }
+    LibintUnsigned operand;
+    libint_unsigned_set_uintmax(&operand, y);
+    return E(libint_unsigned_sub_replace(libint, x, &operand));
+}
+
+LibintError libint_unsigned_mul_ui_replace(Libint *libint, LibintUnsigned **x, uintmax_t y) {
+    if (!libint || !x) {
+        return LIBINT_ERROR_BAD_ARGUMENT;
+    }
+    LibintUnsigned operand;
+    libint_unsigned_set_uintmax(&operand, y);
+    return E(libint_unsigned_mul_replace(libint, x, &operand));
+}
+
+LibintError libint_unsigned_div_mod_ui_replace(Libint *libint, LibintUnsigned **x, uintmax_t y, uintmax_t *remainder) {
+    LibintError err = LIBINT_ERROR_OK;
+    LibintUnsigned result_remainder;
+    libint_unsigned_init(&result_remainder);
+    if (!libint || !x) {
+        err = LIBINT_ERROR_BAD_ARGUMENT;
+        goto end;
+    }
+    if (y == (LibintWord) y) {
+        LibintWord r;
+        err = E(libint_unsigned_div_mod_word_replace(libint, x, y, &r));
+        if (err) goto end;
+        if (remainder) {
+            *remainder = r;
+        }
+        goto end;
+    }
+    // The quotient goes into *x, so that it keeps its place outside of an arena.
+    LibintUnsigned operand;
+    libint_unsigned_set_uintmax(&operand, y);
+    err = E(libint_unsigned_div_mod_into(libint, *x, remainder ? &result_remainder : NULL, *x, &operand));
+    if (err) goto end;
+    if (remainder) {
+        err = E(libint_unsigned_to_uintmax(libint, &result_remainder, remainder));
+        if (err) goto end;
+    }
+end:
+    libint_unsigned_release(libint, &result_remainder);
+    return err;
+}
+
+LibintError libint_unsigned_compare_ui(Libint *libint, LibintUnsigned *x, uintmax_t y, int *order) {
+    if (!libint || !x || !order) {
+        return LIBINT_ERROR_BAD_ARGUMENT;
+    }
+    LibintUnsigned operand;
+    libint_unsigned_set_uintmax(&operand, y);
+    return E(libint_unsigned_compare(libint, x, &operand, order));
+}
@@ -0,0 +1,516 @@
+#include "libint_internal.h"
+
+#include <assert.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+static LibintWord add_portable(
+        LibintWord *out, const LibintWord *x, size_t x_size, const LibintWord *y, size_t y_size) {
+    assert(out && x && y && x_size >= y_size);
+    LibintWord carry = 0;
+    size_t i = 0;
+    for (; i < y_size; ++i) {
+        LibintDword t = (LibintDword) x[i] + y[i] + carry;
+        out[i] = (LibintWord) t;
+        carry = (LibintWord) (t >> LIBINT_WORD_BITS);
+    }
+    for (; i < x_size; ++i) {
+        LibintWord a = x[i];
+        out[i] = a + carry;
+        carry = out[i] < a;
+    }
+    return carry;
+}
+
+static LibintWord sub_portable(
+        LibintWord *out, const LibintWord *x, size_t x_size, const LibintWord *y, size_t y_size) {
+    assert(out && x && y && x_size >= y_size);
+    LibintWord borrow = 0;
+    size_t i = 0;
+    for (; i < y_size; ++i) {
+        LibintWord a = x[i];
+        LibintWord b = y[i];
+        LibintWord d = a - b;
+        out[i] = d - borrow;
+        borrow = (a < b) | (d < borrow);
+    }
+    for (; i < x_size; ++i) {
+        LibintWord a = x[i];
+        out[i] = a - borrow;
+        borrow = a < borrow;
+    }
+    return borrow;
+}
+
+#if defined(__GNUC__) || defined(__clang__)
+#define LIBINT_VECTORS
+
+// Vector of words, GCC and Clang compile operations on it to SSE2 on x86-64, NEON on AArch64 and to scalar code
+// elsewhere. Loads and stores go through memcpy, because words are not aligned to vectors.
+typedef LibintWord LibintVector __attribute__((vector_size(16)));
+#define VECTOR_WORDS (sizeof(LibintVector) / sizeof(LibintWord))
+
+static inline LibintVector vector_load(const LibintWord *x) {
+    LibintVector v;
+    memcpy(&v, x, sizeof(v));
+    return v;
+}
+
+static inline void vector_store(LibintWord *out, LibintVector v) {
+    memcpy(out, &v, sizeof(v));
+}
+
+static inline bool vector_is_zero(LibintVector v) {
+    LibintWord any = 0;
+    for (size_t i = 0; i < VECTOR_WORDS; ++i) {
+        any |= v[i];
+    }
+    return !any;
+}
+#endif
+
+size_t libint_words_normalized_size(const LibintWord *x, size_t size) {
+    assert(x && size);
+#ifdef LIBINT_VECTORS
+    // Skips four vectors of zeros at a time.
+    while (size > 4 * VECTOR_WORDS) {
+        const LibintWord *top = x + size - 4 * VECTOR_WORDS;
+        LibintVector any = vector_load(top) | vector_load(top + VECTOR_WORDS) |
+                           vector_load(top + 2 * VECTOR_WORDS) | vector_load(top + 3 * VECTOR_WORDS);
+        if (!vector_is_zero(any)) {
+            break;
+        }
+        size -= 4 * VECTOR_WORDS;
+    }
+#endif
+    while (size > 1 && !x[size - 1]) {
+        --size;
+    }
+    return size;
+}
+
+int libint_words_compare(const LibintWord *x, const LibintWord *y, size_t size) {
+    assert(x && y);
+#ifdef LIBINT_VECTORS
+    // Skips four equal vectors at a time, the first difference is then found by the scalar loop.
+    while (size >= 4 * VECTOR_WORDS) {
+        const LibintWord *x_top = x + size - 4 * VECTOR_WORDS;
+        const LibintWord *y_top = y + size - 4 * VECTOR_WORDS;
+        LibintVector difference = (vector_load(x_top) ^ vector_load(y_top)) |
+                                  (vector_load(x_top + VECTOR_WORDS) ^ vector_load(y_top + VECTOR_WORDS)) |
+                                  (vector_load(x_top + 2 * VECTOR_WORDS) ^ vector_load(y_top + 2 * VECTOR_WORDS)) |
+                                  (vector_load(x_top + 3 * VECTOR_WORDS) ^ vector_load(y_top + 3 * VECTOR_WORDS));
+        if (!vector_is_zero(difference)) {
+            break;
+        }
+        size -= 4 * VECTOR_WORDS;
+    }
+#endif
+    while (size--) {
+        if (x[size] != y[size]) {
+            return x[size] < y[size] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+LibintWord libint_words_lshift(LibintWord *out, const LibintWord *x, size_t size, unsigned bits) {
+    assert(out && x && 0 < bits && bits < LIBINT_WORD_BITS);
+    LibintWord shifted_out = 0;
+    if (size) {
+        shifted_out = x[size - 1] >> (LIBINT_WORD_BITS - bits);
+        size_t i = size - 1;
+#ifdef LIBINT_VECTORS
+        // Goes down, so every vector is read before it is overwritten when out is x.
+        for (; i >= VECTOR_WORDS; i -= VECTOR_WORDS) {
+            const LibintWord *high = x + i - VECTOR_WORDS + 1;
+            LibintVector v = (vector_load(high) << bits) | (vector_load(high - 1) >> (LIBINT_WORD_BITS - bits));
+            vector_store(out + i - VECTOR_WORDS + 1, v);
+        }
+#endif
+        for (; i; --i) {
+            out[i] = (x[i] << bits) | (x[i - 1] >> (LIBINT_WORD_BITS - bits));
+        }
+        out[0] = x[0] << bits;
+    }
+    return shifted_out;
+}
+
+LibintWord libint_words_rshift(LibintWord *out, const LibintWord *x, size_t size, unsigned bits) {
+    assert(out && x && 0 < bits && bits < LIBINT_WORD_BITS);
+    LibintWord shifted_out = 0;
+    if (size) {
+        shifted_out = x[0] << (LIBINT_WORD_BITS - bits);
+        size_t i = 0;
+#ifdef LIBINT_VECTORS
+        for (; i + VECTOR_WORDS < size; i += VECTOR_WORDS) {
+            LibintVector v = (vector_load(x + i) >> bits) | (vector_load(x + i + 1) << (LIBINT_WORD_BITS - bits));
+            vector_store(out + i, v);
+        }
+#endif
+        for (; i + 1 < size; ++i) {
+            out[i] = (x[i] >> bits) | (x[i + 1] << (LIBINT_WORD_BITS - bits));
+        }
+        out[size - 1] = x[size - 1] >> bits;
+    }
+    return shifted_out;
+}
+
+unsigned libint_words_leading_zeros(LibintWord x) {
+    assert(x);
+#if defined(__GNUC__) || defined(__clang__)
+    if (sizeof(LibintWord) == sizeof(unsigned long long)) {
+        return (unsigned) __builtin_clzll(x);
+    }
+    return (unsigned) __builtin_clzl(x) - (unsigned) (sizeof(unsigned long) - sizeof(LibintWord)) * CHAR_BIT;
+#else
+    // Binary search, the halves that are zero are shifted out.
+    unsigned count = 0;
+    for (unsigned half = LIBINT_WORD_BITS / 2; half; half /= 2) {
+        if (!(x >> (LIBINT_WORD_BITS - half))) {
+            x <<= half;
+            count += half;
+        }
+    }
+    return count;
+#endif
+}
+
+unsigned libint_words_trailing_zeros(LibintWord x) {
+    assert(x);
+#if defined(__GNUC__) || defined(__clang__)
+    if (sizeof(LibintWord) == sizeof(unsigned long long)) {
+        return (unsigned) __builtin_ctzll(x);
+    }
+    return (unsigned) __builtin_ctzl(x);
+#else
+    unsigned count = 0;
+    for (unsigned half = LIBINT_WORD_BITS / 2; half; half /= 2) {
+        if (!(x << (LIBINT_WORD_BITS - half))) {
+            x >>= half;
+            count += half;
+        }
+    }
+    return count;
+#endif
+}
+
+// From this size on computing the reciprocal pays off.
+#define DIV_WORD_RECIPROCAL_THRESHOLD 4
+
+LibintWord libint_words_div_word(LibintWord *out, const LibintWord *x, size_t size, LibintWord y) {
+    assert(out && x && y);
+    if (size >= DIV_WORD_RECIPROCAL_THRESHOLD) {
+        LibintWordReciprocal reciprocal;
+        libint_words_reciprocal(&reciprocal, y);
+        return libint_words_div_word_reciprocal(out, x, size, &reciprocal);
+    }
+    LibintWord remainder = 0;
+    for (size_t i = size; i--;) {
+        LibintDword t = ((LibintDword) remainder << LIBINT_WORD_BITS) | x[i];
+        out[i] = (LibintWord) (t / y);
+        remainder = (LibintWord) (t % y);
+    }
+    return remainder;
+}
+
+void libint_words_reciprocal(LibintWordReciprocal *out, LibintWord y) {
+    assert(out && y);
+    out->divisor = y;
+    out->shift = libint_words_leading_zeros(y);
+    out->normalized = y << out->shift;
+    // B^2 - 1 - normalized * B fits into a double word and the quotient is less than B.
+    LibintDword numerator = ((LibintDword) (LibintWord) ~out->normalized << LIBINT_WORD_BITS) | (LibintWord) ~0;
+    out->reciprocal = (LibintWord) (numerator / out->normalized);
+}
+
+// Divides high:low by normalized d, where high < d. Stores the remainder into *remainder and returns the quotient.
+static LibintWord div_2by1(LibintWord *remainder, LibintWord high, LibintWord low, LibintWord d, LibintWord v) {
+    LibintDword q = (LibintDword) v * high + (((LibintDword) high << LIBINT_WORD_BITS) | low);
+    LibintWord q1 = (LibintWord) (q >> LIBINT_WORD_BITS) + 1;
+    LibintWord q0 = (LibintWord) q;
+    LibintWord r = (LibintWord) (low - q1 * d);
+    if (r > q0) {
+        --q1;
+        r += d;
+    }
+    if (r >= d) {
+        ++q1;
+        r -= d;
+    }
+    *remainder = r;
+    return q1;
+}
+
+LibintWord libint_words_div_word_reciprocal(
+        LibintWord *out, const LibintWord *x, size_t size, const LibintWordReciprocal *y) {
+    assert(out && x && y);
+    LibintWord d = y->normalized;
+    LibintWord v = y->reciprocal;
+    unsigned shift = y->shift;
+    LibintWord remainder = 0;
+    if (!size) {
+        return remainder;
+    }
+    if (shift) {
+        // Shift x on the fly, words of x are read before they are overwritten.
+        remainder = x[size - 1] >> (LIBINT_WORD_BITS - shift);
+        for (size_t i = size; i--;) {
+            LibintWord low = x[i] << shift;
+            if (i) {
+                low |= x[i - 1] >> (LIBINT_WORD_BITS - shift);
+            }
+            out[i] = div_2by1(&remainder, remainder, low, d, v);
+        }
+    } else {
+        for (size_t i = size; i--;) {
+            out[i] = div_2by1(&remainder, remainder, x[i], d, v);
+        }
+    }
+    return remainder >> shift;
+}
+
+static LibintWord mul_word_portable(LibintWord *out, const LibintWord *x, size_t size, LibintWord y) {
+    assert(out && x);
+    LibintWord carry = 0;
+    for (size_t i = 0; i < size; ++i) {
+        LibintDword t = (LibintDword) x[i] * y + carry;
+        out[i] = (LibintWord) t;
+        carry = (LibintWord) (t >> LIBINT_WORD_BITS);
+    }
+    return carry;
+}
+
+static LibintWord addmul_word_portable(LibintWord *out, const LibintWord *x, size_t size, LibintWord y) {
+    assert(out && x);
+    LibintWord carry = 0;
+    for (size_t i = 0; i < size; ++i) {
+        // x[i] * y + out[i] + carry fits into LibintDword: (b - 1)^2 + 2(b - 1) = b^2 - 1.
+        LibintDword t = (LibintDword) x[i] * y + out[i] + carry;
+        out[i] = (LibintWord) t;
+        carry = (LibintWord) (t >> LIBINT_WORD_BITS);
+    }
+    return carry;
+}
+
+static LibintWord submul_word_portable(LibintWord *out, const LibintWord *x, size_t size, LibintWord y) {
+    assert(out && x);
+    LibintWord borrow = 0;
+    for (size_t i = 0; i < size; ++i) {
+        LibintDword t = (LibintDword) x[i] * y + borrow;
+        LibintWord lo = (LibintWord) t;
+        borrow = (LibintWord) (t >> LIBINT_WORD_BITS) + (out[i] < lo);
+        out[i] -= lo;
+    }
+    return borrow;
+}
+
+#if defined(LIBINT_64_BIT_WORDS) && defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define LIBINT_X86_KERNELS
+#endif
+
+#ifdef LIBINT_X86_KERNELS
+#include <cpuid.h>
+
+// Compilers keep the carry of intrinsics such as _addcarry_u64 in a register between iterations, so the loops are
+// written in assembly to keep it in the flags. dec and lea leave the carry flag alone.
+
+// out = x + y, where all have size > 0 words. Returns the carry.
+static LibintWord add_n_x86(LibintWord *out, const LibintWord *x, const LibintWord *y, size_t size) {
+    LibintWord carry;
+    LibintWord t;
+    __asm__("xor %k[carry], %k[carry]\n"
+            "1:\n\t"
+            "mov (%[x]), %[t]\n\t"
+            "adc (%[y]), %[t]\n\t"
+            "mov %[t], (%[out])\n\t"
+            "lea 8(%[x]), %[x]\n\t"
+            "lea 8(%[y]), %[y]\n\t"
+            "lea 8(%[out]), %[out]\n\t"
+            "dec %[size]\n\t"
+            "jnz 1b\n\t"
+            "setc %b[carry]"
+            : [carry] "=&r"(carry), [t] "=&r"(t), [out] "+r"(out), [x] "+r"(x), [y] "+r"(y), [size] "+r"(size)
+            :
+            : "cc", "memory");
+    return carry;
+}
+
+static LibintWord sub_n_x86(LibintWord *out, const LibintWord *x, const LibintWord *y, size_t size) {
+    LibintWord borrow;
+    LibintWord t;
+    __asm__("xor %k[borrow], %k[borrow]\n"
+            "1:\n\t"
+            "mov (%[x]), %[t]\n\t"
+            "sbb (%[y]), %[t]\n\t"
+            "mov %[t], (%[out])\n\t"
+            "lea 8(%[x]), %[x]\n\t"
+            "lea 8(%[y]), %[y]\n\t"
+            "lea 8(%[out]), %[out]\n\t"
+            "dec %[size]\n\t"
+            "jnz 1b\n\t"
+            "setc %b[borrow]"
+            : [borrow] "=&r"(borrow), [t] "=&r"(t), [out] "+r"(out), [x] "+r"(x), [y] "+r"(y), [size] "+r"(size)
+            :
+            : "cc", "memory");
+    return borrow;
+}
+
+static LibintWord add_x86(LibintWord *out, const LibintWord *x, size_t x_size, const LibintWord *y, size_t y_size) {
+    assert(out && x && y && x_size >= y_size);
+    LibintWord carry = y_size ? add_n_x86(out, x, y, y_size) : 0;
+    for (size_t i = y_size; i < x_size; ++i) {
+        LibintWord a = x[i];
+        out[i] = a + carry;
+        carry = out[i] < a;
+    }
+    return carry;
+}
+
+static LibintWord sub_x86(LibintWord *out, const LibintWord *x, size_t x_size, const LibintWord *y, size_t y_size) {
+    assert(out && x && y && x_size >= y_size);
+    LibintWord borrow = y_size ? sub_n_x86(out, x, y, y_size) : 0;
+    for (size_t i = y_size; i < x_size; ++i) {
+        LibintWord a = x[i];
+        out[i] = a - borrow;
+        borrow = a < borrow;
+    }
+    return borrow;
+}
+
+// mulx leaves the flags alone, so the high word of the previous product is added by adcx, which uses only the carry
+// flag, and out[i] by adox, which uses only the overflow flag. jrcxz and lea keep both. The final high word is at
+// most B - 2, so adding the carries to it does not overflow.
+static LibintWord mul_word_adx(LibintWord *out, const LibintWord *x, size_t size, LibintWord y) {
+    assert(out && x);
+    LibintWord high = 0;
+    LibintWord zero;
+    LibintWord low;
+    LibintWord next_high;
+    __asm__("xor %k[zero], %k[zero]\n"
+            "1:\n\t"
+            "jrcxz 2f\n\t"
+            "mulx (%[x]), %[low], %[next_high]\n\t"
+            "adcx %[high], %[low]\n\t"
+            "mov %[low], (%[out])\n\t"
+            "mov %[next_high], %[high]\n\t"
+            "lea 8(%[x]), %[x]\n\t"
+            "lea 8(%[out]), %[out]\n\t"
+            "lea -1(%[size]), %[size]\n\t"
+            "jmp 1b\n"
+            "2:\n\t"
+            "adcx %[zero], %[high]"
+            : [high] "+&r"(high), [zero] "=&r"(zero), [low] "=&r"(low), [next_high] "=&r"(next_high),
+              [out] "+r"(out), [x] "+r"(x), [size] "+c"(size)
+            : "d"(y)
+            : "cc", "memory");
+    return high;
+}
+
+static LibintWord addmul_word_adx(LibintWord *out, const LibintWord *x, size_t size, LibintWord y) {
+    assert(out && x);
+    LibintWord high = 0;
+    LibintWord zero;
+    LibintWord low;
+    LibintWord next_high;
+    __asm__("xor %k[zero], %k[zero]\n"
+            "1:\n\t"
+            "jrcxz 2f\n\t"
+            "mulx (%[x]), %[low], %[next_high]\n\t"
+            "adcx %[high], %[low]\n\t"
+            "adox (%[out]), %[low]\n\t"
+            "mov %[low], (%[out])\n\t"
+            "mov %[next_high], %[high]\n\t"
+            "lea 8(%[x]), %[x]\n\t"
+            "lea 8(%[out]), %[out]\n\t"
+            "lea -1(%[size]), %[size]\n\t"
+            "jmp 1b\n"
+            "2:\n\t"
+            "adcx %[zero], %[high]\n\t"
+            "adox %[zero], %[high]"
+            : [high] "+&r"(high), [zero] "=&r"(zero), [low] "=&r"(low), [next_high] "=&r"(next_high),
+              [out] "+r"(out), [x] "+r"(x), [size] "+c"(size)
+            : "d"(y)
+            : "cc", "memory");
+    return high;
+}
+#endif
+
+const LibintWordKernels libint_words_portable_kernels = {
+        add_portable, sub_portable, mul_word_portable, addmul_word_portable, submul_word_portable,
+};
+
+// Kernels in use. They are only replaced by select_kernels before main, so reading them needs no synchronization.
+static LibintWordKernels kernels = {
+        add_portable, sub_portable, mul_word_portable, addmul_word_portable, submul_word_portable,
+};
+
+#ifdef LIBINT_X86_KERNELS
+// Chooses the fastest kernels for the processor once, when the program or the shared library is loaded.
+__attribute__((constructor)) static void select_kernels(void) {
+    const char *requested = getenv("LIBINT_KERNELS");
+    if (requested && !strcmp(requested, "portable")) {
+        return;
+    }
+    kernels.add = add_x86;
+    kernels.sub = sub_x86;
+    unsigned eax, ebx, ecx, edx;
+    if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) && (ebx & bit_BMI2) && (ebx & bit_ADX)) {
+        kernels.mul_word = mul_word_adx;
+        kernels.addmul_word = addmul_word_adx;
+    }
+}
+#endif
+
+LibintWord libint_words_add(
+        LibintWord *out, const LibintWord *x, size_t x_size, const LibintWord *y, size_t y_size) {
+    return kernels.add(out, x, x_size, y, y_size);
+}
+
+LibintWord libint_words_sub(
+        LibintWord *out, const LibintWord *x, size_t x_size, const LibintWord *y, size_t y_size) {
+    return kernels.sub(out, x, x_size, y, y_size);
+}
+
+LibintWord libint_words_mul_word(LibintWord *out, const LibintWord *x, size_t size, LibintWord y) {
+    return kernels.mul_word(out, x, size, y);
+}
+
+LibintWord libint_words_addmul_word(LibintWord *out, const LibintWord *x, size_t size, LibintWord y) {
+    return kernels.addmul_word(out, x, size, y);
+}
+
+LibintWord libint_words_submul_word(LibintWord *out, const LibintWord *x, size_t size, LibintWord y) {
+    return kernels.submul_word(out, x, size, y);
+}
+
+void libint_words_mul_basecase(
+        LibintWord *out, const LibintWord *x, size_t x_size, const LibintWord *y, size_t y_size) {
+    assert(out && x && y && x_size && y_size);
+    out[x_size] = libint_words_mul_word(out, x, x_size, y[0]);
+    for (size_t j = 1; j < y_size; ++j) {
+        out[x_size + j] = libint_words_addmul_word(out + j, x, x_size, y[j]);
+    }
+}
+
+void libint_words_sqr_basecase(LibintWord *out, const LibintWord *x, size_t size) {
+    assert(out && x && size);
+    // Cross products x[i] * x[j] for i < j, every one computed once and then doubled.
+    memset(out, 0, 2 * size * sizeof(LibintWord));
+    for (size_t i = 0; i + 1 < size; ++i) {
+        out[size + i] = libint_words_addmul_word(out + 2 * i + 1, x + i + 1, size - i - 1, x[i]);
+    }
+    libint_words_lshift(out, out, 2 * size, 1);
+    LibintWord carry = 0;
+    for (size_t i = 0; i < size; ++i) {
+        LibintDword square = (LibintDword) x[i] * x[i];
+        LibintDword lo = (LibintDword) out[2 * i] + (LibintWord) square + carry;
+        out[2 * i] = (LibintWord) lo;
+        LibintDword hi = (LibintDword) out[2 * i + 1] + (LibintWord) (square >> LIBINT_WORD_BITS)
+                         + (LibintWord) (lo >> LIBINT_WORD_BITS);
+        out[2 * i + 1] = (LibintWord) hi;
+        carry = (LibintWord) (hi >> LIBINT_WORD_BITS);
+    }
+    assert(!carry);
+}
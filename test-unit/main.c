@@ -1,9 +1,12 @@
 #include <libint.h>
+// The word kernels are checked directly against their portable versions.
+#include <libint_internal.h>
 
 #include <math.h>
 #include <assert.h>
 #include <inttypes.h>
 #include <limits.h>
+#include <string.h>
 
 static Libint *libint;
 
@@ -294,42 +297,1935 @@ void test_div_floor(intmax_t a, intmax_t b) {
     libint_destroy(libint, &expected_remainder);
 }
 
+static LibintUnsigned *random_unsigned(size_t digits) {
+    static const char *hex = "0123456789ABCDEF";
+    char *str = malloc(digits);
+    assert(str);
+    for (size_t i = 0; i < digits; ++i) {
+        str[i] = hex[rand() % 16];
+    }
+    LibintUnsigned *x;
+    const char *end_of_input;
+    LibintError err = libint_unsigned_from_string(libint, &x, str, digits, 16, &end_of_input);
+    assert(LIBINT_ERROR_OK == err);
+    free(str);
+    return x;
+}
+
+// (16^n - 1)^2 = 16^2n - 2 * 16^n + 1 = F..FE0..01 in hexadecimal
+void test_mul_big_square_of_ones(size_t n) {
+    LibintError err;
+
+    char *str = malloc(2 * n);
+    assert(str);
+    memset(str, 'F', n);
+
+    LibintUnsigned *x;
+    const char *end_of_input;
+    err = libint_unsigned_from_string(libint, &x, str, n, 16, &end_of_input);
+    assert(LIBINT_ERROR_OK == err);
+
+    LibintUnsigned *product;
+    err = libint_unsigned_mul(libint, &product, x, x);
+    assert(LIBINT_ERROR_OK == err);
+
+    memset(str, 'F', n - 1);
+    str[n - 1] = 'E';
+    memset(str + n, '0', n - 1);
+    str[2 * n - 1] = '1';
+    LibintUnsigned *expected_product;
+    err = libint_unsigned_from_string(libint, &expected_product, str, 2 * n, 16, &end_of_input);
+    assert(LIBINT_ERROR_OK == err);
+
+    int order;
+    err = libint_unsigned_compare(libint, product, expected_product, &order);
+    assert(LIBINT_ERROR_OK == err);
+
+    assert(!order);
+
+    free(str);
+    libint_unsigned_destroy(libint, &x);
+    libint_unsigned_destroy(libint, &product);
+    libint_unsigned_destroy(libint, &expected_product);
+}
+
+// x * y / y = x and x * y % y = 0
+void test_mul_big(size_t x_digits, size_t y_digits) {
+    LibintError err;
+
+    LibintUnsigned *x = random_unsigned(x_digits);
+    LibintUnsigned *y = random_unsigned(y_digits);
+
+    bool is_zero;
+    err = libint_unsigned_is_zero(libint, y, &is_zero);
+    assert(LIBINT_ERROR_OK == err);
+    if (is_zero) {
+        libint_unsigned_add_replace(libint, &y, x);
+    }
+
+    LibintUnsigned *product;
+    err = libint_unsigned_mul(libint, &product, x, y);
+    assert(LIBINT_ERROR_OK == err);
+
+    LibintUnsigned *quotient, *remainder;
+    err = libint_unsigned_div_mod(libint, &quotient, &remainder, product, y);
+    assert(LIBINT_ERROR_OK == err);
+
+    int order;
+    err = libint_unsigned_compare(libint, quotient, x, &order);
+    assert(LIBINT_ERROR_OK == err);
+
+    assert(!order);
+
+    err = libint_unsigned_is_zero(libint, remainder, &is_zero);
+    assert(LIBINT_ERROR_OK == err);
+
+    assert(is_zero);
+
+    libint_unsigned_destroy(libint, &x);
+    libint_unsigned_destroy(libint, &y);
+    libint_unsigned_destroy(libint, &product);
+    libint_unsigned_destroy(libint, &quotient);
+    libint_unsigned_destroy(libint, &remainder);
+}
+
+// Karatsuba, Toom-3 and NTT must agree with schoolbook multiplication.
+void test_mul_algorithms(size_t x_digits, size_t y_digits) {
+    LibintError err;
+
+    LibintUnsigned *x = random_unsigned(x_digits);
+    LibintUnsigned *y = random_unsigned(y_digits);
+
+    size_t karatsuba_threshold, toom3_threshold, ntt_threshold;
+    err = libint_get_threshold(libint, LIBINT_THRESHOLD_MUL_KARATSUBA, &karatsuba_threshold);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_get_threshold(libint, LIBINT_THRESHOLD_MUL_TOOM3, &toom3_threshold);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_get_threshold(libint, LIBINT_THRESHOLD_MUL_NTT, &ntt_threshold);
+    assert(LIBINT_ERROR_OK == err);
+
+    err = libint_set_threshold(libint, LIBINT_THRESHOLD_MUL_KARATSUBA, SIZE_MAX);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_set_threshold(libint, LIBINT_THRESHOLD_MUL_NTT, SIZE_MAX);
+    assert(LIBINT_ERROR_OK == err);
+    LibintUnsigned *expected_product;
+    err = libint_unsigned_mul(libint, &expected_product, x, y);
+    assert(LIBINT_ERROR_OK == err);
+
+    size_t thresholds[][3] = {
+            { 2, SIZE_MAX, SIZE_MAX },
+            { 2, 3, SIZE_MAX },
+            { 4, 9, SIZE_MAX },
+            { SIZE_MAX, SIZE_MAX, 1 },
+            { 2, 3, 40 },
+    };
+    for (size_t i = 0; i < sizeof(thresholds) / sizeof(thresholds[0]); ++i) {
+        err = libint_set_threshold(libint, LIBINT_THRESHOLD_MUL_KARATSUBA, thresholds[i][0]);
+        assert(LIBINT_ERROR_OK == err);
+        err = libint_set_threshold(libint, LIBINT_THRESHOLD_MUL_TOOM3, thresholds[i][1]);
+        assert(LIBINT_ERROR_OK == err);
+        err = libint_set_threshold(libint, LIBINT_THRESHOLD_MUL_NTT, thresholds[i][2]);
+        assert(LIBINT_ERROR_OK == err);
+
+        LibintUnsigned *product;
+        err = libint_unsigned_mul(libint, &product, x, y);
+        assert(LIBINT_ERROR_OK == err);
+
+        int order;
+        err = libint_unsigned_compare(libint, product, expected_product, &order);
+        assert(LIBINT_ERROR_OK == err);
+
+        assert(!order);
+
+        libint_unsigned_destroy(libint, &product);
+    }
+
+    err = libint_set_threshold(libint, LIBINT_THRESHOLD_MUL_KARATSUBA, karatsuba_threshold);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_set_threshold(libint, LIBINT_THRESHOLD_MUL_TOOM3, toom3_threshold);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_set_threshold(libint, LIBINT_THRESHOLD_MUL_NTT, ntt_threshold);
+    assert(LIBINT_ERROR_OK == err);
+
+    libint_unsigned_destroy(libint, &x);
+    libint_unsigned_destroy(libint, &y);
+    libint_unsigned_destroy(libint, &expected_product);
+}
+
+// Squaring must agree with schoolbook multiplication for every algorithm.
+void test_sqr_algorithms(size_t digits) {
+    LibintError err;
+
+    LibintUnsigned *x = random_unsigned(digits);
+    LibintUnsigned *x_copy;
+    err = libint_unsigned_copy(libint, &x_copy, x);
+    assert(LIBINT_ERROR_OK == err);
+
+    size_t mul_karatsuba_threshold, ntt_threshold, karatsuba_threshold, toom3_threshold;
+    err = libint_get_threshold(libint, LIBINT_THRESHOLD_MUL_KARATSUBA, &mul_karatsuba_threshold);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_get_threshold(libint, LIBINT_THRESHOLD_MUL_NTT, &ntt_threshold);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_get_threshold(libint, LIBINT_THRESHOLD_SQR_KARATSUBA, &karatsuba_threshold);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_get_threshold(libint, LIBINT_THRESHOLD_SQR_TOOM3, &toom3_threshold);
+    assert(LIBINT_ERROR_OK == err);
+
+    err = libint_set_threshold(libint, LIBINT_THRESHOLD_MUL_KARATSUBA, SIZE_MAX);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_set_threshold(libint, LIBINT_THRESHOLD_MUL_NTT, SIZE_MAX);
+    assert(LIBINT_ERROR_OK == err);
+    LibintUnsigned *expected_square;
+    err = libint_unsigned_mul(libint, &expected_square, x, x_copy);
+    assert(LIBINT_ERROR_OK == err);
+
+    size_t thresholds[][3] = {
+            { SIZE_MAX, SIZE_MAX, SIZE_MAX },
+            { 2, SIZE_MAX, SIZE_MAX },
+            { 2, 3, SIZE_MAX },
+            { 4, 9, SIZE_MAX },
+            { SIZE_MAX, SIZE_MAX, 1 },
+    };
+    for (size_t i = 0; i < sizeof(thresholds) / sizeof(thresholds[0]); ++i) {
+        err = libint_set_threshold(libint, LIBINT_THRESHOLD_SQR_KARATSUBA, thresholds[i][0]);
+        assert(LIBINT_ERROR_OK == err);
+        err = libint_set_threshold(libint, LIBINT_THRESHOLD_SQR_TOOM3, thresholds[i][1]);
+        assert(LIBINT_ERROR_OK == err);
+        err = libint_set_threshold(libint, LIBINT_THRESHOLD_MUL_NTT, thresholds[i][2]);
+        assert(LIBINT_ERROR_OK == err);
+
+        LibintUnsigned *square;
+        err = libint_unsigned_sqr(libint, &square, x);
+        assert(LIBINT_ERROR_OK == err);
+
+        int order;
+        err = libint_unsigned_compare(libint, square, expected_square, &order);
+        assert(LIBINT_ERROR_OK == err);
+
+        assert(!order);
+
+        libint_unsigned_destroy(libint, &square);
+    }
+
+    err = libint_set_threshold(libint, LIBINT_THRESHOLD_MUL_KARATSUBA, mul_karatsuba_threshold);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_set_threshold(libint, LIBINT_THRESHOLD_MUL_NTT, ntt_threshold);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_set_threshold(libint, LIBINT_THRESHOLD_SQR_KARATSUBA, karatsuba_threshold);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_set_threshold(libint, LIBINT_THRESHOLD_SQR_TOOM3, toom3_threshold);
+    assert(LIBINT_ERROR_OK == err);
+
+    libint_unsigned_destroy(libint, &x);
+    libint_unsigned_destroy(libint, &x_copy);
+    libint_unsigned_destroy(libint, &expected_square);
+}
+
+static void test_div_mod_unsigned(LibintUnsigned *x, LibintUnsigned *y) {
+    LibintError err;
+
+    LibintUnsigned *quotient, *remainder;
+    err = libint_unsigned_div_mod(libint, &quotient, &remainder, x, y);
+    assert(LIBINT_ERROR_OK == err);
+
+    int order;
+    err = libint_unsigned_compare(libint, remainder, y, &order);
+    assert(LIBINT_ERROR_OK == err);
+
+    assert(order < 0);
+
+    err = libint_unsigned_mul_replace(libint, &quotient, y);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_unsigned_add_replace(libint, &quotient, remainder);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_unsigned_compare(libint, quotient, x, &order);
+    assert(LIBINT_ERROR_OK == err);
+
+    assert(!order);
+
+    libint_unsigned_destroy(libint, &quotient);
+    libint_unsigned_destroy(libint, &remainder);
+}
+
+// x = y * (x / y) + x % y and x % y < y
+void test_div_mod_big(size_t x_digits, size_t y_digits) {
+    LibintUnsigned *x = random_unsigned(x_digits);
+    LibintUnsigned *y = random_unsigned(y_digits);
+
+    bool is_zero;
+    LibintError err = libint_unsigned_is_zero(libint, y, &is_zero);
+    assert(LIBINT_ERROR_OK == err);
+    if (!is_zero) {
+        test_div_mod_unsigned(x, y);
+    }
+
+    libint_unsigned_destroy(libint, &x);
+    libint_unsigned_destroy(libint, &y);
+}
+
+// Recursive and Newton division must agree with schoolbook division.
+void test_div_algorithms(size_t x_digits, size_t y_digits) {
+    LibintError err;
+
+    LibintUnsigned *x = random_unsigned(x_digits);
+    LibintUnsigned *y = random_unsigned(y_digits);
+    bool is_zero;
+    err = libint_unsigned_is_zero(libint, y, &is_zero);
+    assert(LIBINT_ERROR_OK == err);
+    if (is_zero) {
+        libint_unsigned_destroy(libint, &x);
+        libint_unsigned_destroy(libint, &y);
+        return;
+    }
+
+    size_t burnikel_ziegler_threshold, newton_threshold;
+    err = libint_get_threshold(libint, LIBINT_THRESHOLD_DIV_BURNIKEL_ZIEGLER, &burnikel_ziegler_threshold);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_get_threshold(libint, LIBINT_THRESHOLD_DIV_NEWTON, &newton_threshold);
+    assert(LIBINT_ERROR_OK == err);
+
+    err = libint_set_threshold(libint, LIBINT_THRESHOLD_DIV_BURNIKEL_ZIEGLER, SIZE_MAX);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_set_threshold(libint, LIBINT_THRESHOLD_DIV_NEWTON, SIZE_MAX);
+    assert(LIBINT_ERROR_OK == err);
+    LibintUnsigned *expected_quotient, *expected_remainder;
+    err = libint_unsigned_div_mod(libint, &expected_quotient, &expected_remainder, x, y);
+    assert(LIBINT_ERROR_OK == err);
+
+    size_t thresholds[][2] = {
+            { 2, SIZE_MAX },
+            { 3, SIZE_MAX },
+            { 8, SIZE_MAX },
+            { 33, SIZE_MAX },
+            { 2, 3 },
+            { 2, 5 },
+            { 4, 17 },
+            { 8, 40 },
+    };
+    for (size_t i = 0; i < sizeof(thresholds) / sizeof(thresholds[0]); ++i) {
+        err = libint_set_threshold(libint, LIBINT_THRESHOLD_DIV_BURNIKEL_ZIEGLER, thresholds[i][0]);
+        assert(LIBINT_ERROR_OK == err);
+        err = libint_set_threshold(libint, LIBINT_THRESHOLD_DIV_NEWTON, thresholds[i][1]);
+        assert(LIBINT_ERROR_OK == err);
+
+        LibintUnsigned *quotient, *remainder;
+        err = libint_unsigned_div_mod(libint, &quotient, &remainder, x, y);
+        assert(LIBINT_ERROR_OK == err);
+
+        int order;
+        err = libint_unsigned_compare(libint, quotient, expected_quotient, &order);
+        assert(LIBINT_ERROR_OK == err);
+
+        assert(!order);
+
+        err = libint_unsigned_compare(libint, remainder, expected_remainder, &order);
+        assert(LIBINT_ERROR_OK == err);
+
+        assert(!order);
+
+        libint_unsigned_destroy(libint, &quotient);
+        libint_unsigned_destroy(libint, &remainder);
+    }
+
+    err = libint_set_threshold(libint, LIBINT_THRESHOLD_DIV_BURNIKEL_ZIEGLER, burnikel_ziegler_threshold);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_set_threshold(libint, LIBINT_THRESHOLD_DIV_NEWTON, newton_threshold);
+    assert(LIBINT_ERROR_OK == err);
+
+    libint_unsigned_destroy(libint, &x);
+    libint_unsigned_destroy(libint, &y);
+    libint_unsigned_destroy(libint, &expected_quotient);
+    libint_unsigned_destroy(libint, &expected_remainder);
+}
+
+// Division by a divider must agree with division by the number it was created from.
+void test_divider(size_t y_digits, size_t burnikel_ziegler_threshold, size_t newton_threshold,
+                  size_t divider_newton_threshold) {
+    LibintError err;
+
+    LibintUnsigned *y = random_unsigned(y_digits);
+    bool is_zero;
+    err = libint_unsigned_is_zero(libint, y, &is_zero);
+    assert(LIBINT_ERROR_OK == err);
+    if (is_zero) {
+        libint_unsigned_destroy(libint, &y);
+        return;
+    }
+
+    size_t old_burnikel_ziegler_threshold, old_newton_threshold, old_divider_newton_threshold;
+    err = libint_get_threshold(libint, LIBINT_THRESHOLD_DIV_BURNIKEL_ZIEGLER, &old_burnikel_ziegler_threshold);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_get_threshold(libint, LIBINT_THRESHOLD_DIV_NEWTON, &old_newton_threshold);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_get_threshold(libint, LIBINT_THRESHOLD_DIVIDER_NEWTON, &old_divider_newton_threshold);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_set_threshold(libint, LIBINT_THRESHOLD_DIV_BURNIKEL_ZIEGLER, burnikel_ziegler_threshold);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_set_threshold(libint, LIBINT_THRESHOLD_DIV_NEWTON, newton_threshold);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_set_threshold(libint, LIBINT_THRESHOLD_DIVIDER_NEWTON, divider_newton_threshold);
+    assert(LIBINT_ERROR_OK == err);
+
+    LibintDivider *divider;
+    err = libint_divider_create(libint, &divider, y);
+    assert(LIBINT_ERROR_OK == err);
+
+    for (int i = 0; i < 10; ++i) {
+        LibintUnsigned *x = random_unsigned(1 + rand() % (3 * y_digits));
+
+        LibintUnsigned *expected_quotient, *expected_remainder;
+        err = libint_unsigned_div_mod(libint, &expected_quotient, &expected_remainder, x, y);
+        assert(LIBINT_ERROR_OK == err);
+
+        LibintUnsigned *quotient, *remainder;
+        err = libint_divider_div_mod(libint, &quotient, &remainder, x, divider);
+        assert(LIBINT_ERROR_OK == err);
+
+        int order;
+        err = libint_unsigned_compare(libint, quotient, expected_quotient, &order);
+        assert(LIBINT_ERROR_OK == err);
+
+        assert(!order);
+
+        err = libint_unsigned_compare(libint, remainder, expected_remainder, &order);
+        assert(LIBINT_ERROR_OK == err);
+
+        assert(!order);
+
+        libint_unsigned_destroy(libint, &remainder);
+        err = libint_divider_mod(libint, &remainder, x, divider);
+        assert(LIBINT_ERROR_OK == err);
+        err = libint_unsigned_compare(libint, remainder, expected_remainder, &order);
+        assert(LIBINT_ERROR_OK == err);
+
+        assert(!order);
+
+        libint_unsigned_destroy(libint, &x);
+        libint_unsigned_destroy(libint, &quotient);
+        libint_unsigned_destroy(libint, &remainder);
+        libint_unsigned_destroy(libint, &expected_quotient);
+        libint_unsigned_destroy(libint, &expected_remainder);
+    }
+
+    libint_divider_destroy(libint, &divider);
+
+    err = libint_set_threshold(libint, LIBINT_THRESHOLD_DIV_BURNIKEL_ZIEGLER, old_burnikel_ziegler_threshold);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_set_threshold(libint, LIBINT_THRESHOLD_DIV_NEWTON, old_newton_threshold);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_set_threshold(libint, LIBINT_THRESHOLD_DIVIDER_NEWTON, old_divider_newton_threshold);
+    assert(LIBINT_ERROR_OK == err);
+
+    libint_unsigned_destroy(libint, &y);
+}
+
+// x / y and x % y for a single word y agree with the general division.
+void test_div_mod_word(size_t x_digits, LibintWord y) {
+    LibintError err;
+    LibintUnsigned *x = random_unsigned(x_digits);
+
+    LibintUnsigned *quotient;
+    LibintWord remainder;
+    err = libint_unsigned_div_mod_word(libint, &quotient, x, y, &remainder);
+    assert(LIBINT_ERROR_OK == err);
+
+    LibintUnsigned *y_unsigned;
+    err = libint_unsigned_create(libint, &y_unsigned, y);
+    assert(LIBINT_ERROR_OK == err);
+
+    LibintUnsigned *expected_quotient, *expected_remainder;
+    err = libint_unsigned_div_mod(libint, &expected_quotient, &expected_remainder, x, y_unsigned);
+    assert(LIBINT_ERROR_OK == err);
+
+    int order;
+    err = libint_unsigned_compare(libint, quotient, expected_quotient, &order);
+    assert(LIBINT_ERROR_OK == err);
+
+    assert(!order);
+
+    LibintUnsigned *remainder_unsigned;
+    err = libint_unsigned_create(libint, &remainder_unsigned, remainder);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_unsigned_compare(libint, remainder_unsigned, expected_remainder, &order);
+    assert(LIBINT_ERROR_OK == err);
+
+    assert(!order);
+
+    libint_unsigned_destroy(libint, &x);
+    libint_unsigned_destroy(libint, &y_unsigned);
+    libint_unsigned_destroy(libint, &quotient);
+    libint_unsigned_destroy(libint, &expected_quotient);
+    libint_unsigned_destroy(libint, &expected_remainder);
+    libint_unsigned_destroy(libint, &remainder_unsigned);
+}
+
+// Operands for which the trial quotient of long division is one too big or does not fit the division of the
+// top words, both for 32-bit and 64-bit words.
+void test_div_mod_add_back(void) {
+    static const char *operands[][2] = {
+            { "7FFFFFFF800000000000000000000000", "800000000000000000000001" },
+            { "7FFFFFFFFFFFFFFF800000000000000000000000000000000000000000000000",
+              "800000000000000000000000000000000000000000000001" },
+            { "80000000000000000000000000000000", "800000000000000000000001" },
+            { "8000000000000000000000000000000000000000000000000000000000000000",
+              "800000000000000000000000000000000000000000000001" },
+    };
+    for (size_t i = 0; i < sizeof(operands) / sizeof(operands[0]); ++i) {
+        LibintError err;
+        const char *end_of_input;
+
+        LibintUnsigned *x;
+        err = libint_unsigned_from_string(libint, &x, operands[i][0], strlen(operands[i][0]), 16, &end_of_input);
+        assert(LIBINT_ERROR_OK == err);
+
+        LibintUnsigned *y;
+        err = libint_unsigned_from_string(libint, &y, operands[i][1], strlen(operands[i][1]), 16, &end_of_input);
+        assert(LIBINT_ERROR_OK == err);
+
+        test_div_mod_unsigned(x, y);
+
+        libint_unsigned_destroy(libint, &x);
+        libint_unsigned_destroy(libint, &y);
+    }
+}
+
 extern char *int_to_string(LibintSigned *value, int base) {
     char *out;
     size_t out_size;
     LibintError err = libint_to_string(libint, value, base, &out, &out_size);
     assert(LIBINT_ERROR_OK == err);
-    return out;
+    return out;
+}
+
+void test_str(intmax_t a) {
+    int base = 2 + rand() % (16 - 2);
+
+    LibintError err;
+
+    LibintSigned *x;
+    err = libint_create(libint, &x, a);
+    assert(LIBINT_ERROR_OK == err);
+
+    char *str;
+    size_t str_size;
+    err = libint_to_string(libint, x, base, &str, &str_size);
+    assert(LIBINT_ERROR_OK == err);
+
+    LibintSigned *parsed;
+    const char *end_of_input = NULL;
+    err = libint_from_string(libint, &parsed, str, str_size, base, &end_of_input);
+    assert(LIBINT_ERROR_OK == err);
+
+    int order;
+    err = libint_compare(libint, x, parsed, &order);
+    assert(LIBINT_ERROR_OK == err);
+
+    assert(!order);
+
+    free(str);
+    libint_destroy(libint, &x);
+    libint_destroy(libint, &parsed);
+}
+
+static void assert_equal_unsigned(LibintUnsigned *x, LibintUnsigned *y) {
+    int order;
+    LibintError err = libint_unsigned_compare(libint, x, y, &order);
+    assert(LIBINT_ERROR_OK == err);
+    assert(!order);
+}
+
+// Replacing operations that work in place give the same results as the ones that allocate the result.
+static void test_replace_in_place(size_t x_digits, size_t y_digits) {
+    LibintError err;
+
+    LibintUnsigned *x = random_unsigned(x_digits);
+    LibintUnsigned *y = random_unsigned(y_digits);
+    LibintUnsigned *expected;
+    LibintUnsigned *actual;
+
+    err = libint_unsigned_add(libint, &expected, x, y);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_unsigned_copy(libint, &actual, x);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_unsigned_add_replace(libint, &actual, y);
+    assert(LIBINT_ERROR_OK == err);
+    assert_equal_unsigned(expected, actual);
+
+    // Back to x, keeping the capacity.
+    err = libint_unsigned_sub_replace(libint, &actual, y);
+    assert(LIBINT_ERROR_OK == err);
+    assert_equal_unsigned(x, actual);
+    libint_unsigned_destroy(libint, &expected);
+
+    err = libint_unsigned_add(libint, &expected, x, x);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_unsigned_add_replace(libint, &actual, actual);
+    assert(LIBINT_ERROR_OK == err);
+    assert_equal_unsigned(expected, actual);
+    libint_unsigned_destroy(libint, &expected);
+    libint_unsigned_destroy(libint, &actual);
+
+    // y < 2^y_bits, so its bits are shifted out to the right.
+    int offset = rand() % 150;
+    int y_bits = (int) y_digits * 4;
+    err = libint_unsigned_bitshift(libint, &expected, x, offset);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_unsigned_copy(libint, &actual, x);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_unsigned_bitshift_replace(libint, &actual, offset + y_bits);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_unsigned_add_replace(libint, &actual, y);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_unsigned_bitshift_replace(libint, &actual, -y_bits);
+    assert(LIBINT_ERROR_OK == err);
+    assert_equal_unsigned(expected, actual);
+    err = libint_unsigned_bitshift_replace(libint, &actual, -offset);
+    assert(LIBINT_ERROR_OK == err);
+    assert_equal_unsigned(x, actual);
+    libint_unsigned_destroy(libint, &expected);
+    libint_unsigned_destroy(libint, &actual);
+
+    LibintWord word = (LibintWord) rand() * (LibintWord) rand() + 1;
+    LibintUnsigned *word_long;
+    err = libint_unsigned_create(libint, &word_long, word);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_unsigned_mul(libint, &expected, x, word_long);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_unsigned_copy(libint, &actual, x);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_unsigned_mul_word_replace(libint, &actual, word);
+    assert(LIBINT_ERROR_OK == err);
+    assert_equal_unsigned(expected, actual);
+
+    LibintWord expected_remainder = (LibintWord) rand() % word;
+    LibintUnsigned *remainder_long;
+    err = libint_unsigned_create(libint, &remainder_long, expected_remainder);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_unsigned_add_replace(libint, &actual, remainder_long);
+    assert(LIBINT_ERROR_OK == err);
+    LibintWord remainder;
+    err = libint_unsigned_div_mod_word_replace(libint, &actual, word, &remainder);
+    assert(LIBINT_ERROR_OK == err);
+    assert_equal_unsigned(x, actual);
+    assert(expected_remainder == remainder);
+    libint_unsigned_destroy(libint, &remainder_long);
+    libint_unsigned_destroy(libint, &expected);
+    libint_unsigned_destroy(libint, &actual);
+    libint_unsigned_destroy(libint, &word_long);
+
+    libint_unsigned_destroy(libint, &x);
+    libint_unsigned_destroy(libint, &y);
+}
+
+// Digits of a random number in the given base, with runs of zeros, parsed and converted back to string with and
+// without splitting.
+static void test_str_big(size_t digits, int base) {
+    static const char *alphabet = "0123456789ABCDEF";
+    LibintError err;
+
+    char *str = malloc(digits);
+    assert(str);
+    for (size_t i = 0; i < digits; ++i) {
+        str[i] = alphabet[rand() % 4 ? rand() % base : 0];
+    }
+    str[0] = alphabet[1 + rand() % (base - 1)];
+    if (digits > 20 && rand() % 2) {
+        size_t zeros = rand() % (digits / 2);
+        memset(str + 1 + rand() % (digits - zeros), '0', zeros);
+    }
+
+    size_t from_string_threshold, to_string_threshold;
+    err = libint_get_threshold(libint, LIBINT_THRESHOLD_FROM_STRING_RECURSIVE, &from_string_threshold);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_get_threshold(libint, LIBINT_THRESHOLD_TO_STRING_RECURSIVE, &to_string_threshold);
+    assert(LIBINT_ERROR_OK == err);
+
+    size_t thresholds[] = { SIZE_MAX, 2, 3, 7 };
+    for (size_t i = 0; i < sizeof(thresholds) / sizeof(thresholds[0]); ++i) {
+        err = libint_set_threshold(libint, LIBINT_THRESHOLD_FROM_STRING_RECURSIVE, thresholds[i]);
+        assert(LIBINT_ERROR_OK == err);
+        err = libint_set_threshold(libint, LIBINT_THRESHOLD_TO_STRING_RECURSIVE, thresholds[i]);
+        assert(LIBINT_ERROR_OK == err);
+
+        LibintUnsigned *x;
+        const char *end_of_input;
+        err = libint_unsigned_from_string(libint, &x, str, digits, base, &end_of_input);
+        assert(LIBINT_ERROR_OK == err);
+        assert(end_of_input == str + digits);
+
+        char *out;
+        size_t out_size;
+        err = libint_unsigned_to_string(libint, x, base, &out, &out_size);
+        assert(LIBINT_ERROR_OK == err);
+
+        assert(out_size == digits);
+        assert(!memcmp(out, str, digits));
+        assert(!out[out_size]);
+
+        free(out);
+        libint_unsigned_destroy(libint, &x);
+    }
+
+    err = libint_set_threshold(libint, LIBINT_THRESHOLD_FROM_STRING_RECURSIVE, from_string_threshold);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_set_threshold(libint, LIBINT_THRESHOLD_TO_STRING_RECURSIVE, to_string_threshold);
+    assert(LIBINT_ERROR_OK == err);
+
+    free(str);
+}
+
+typedef struct {
+    size_t allocated;
+    size_t count;
+} CountingState;
+
+static void *counting_allocate(void *state, size_t size) {
+    ++((CountingState *) state)->allocated;
+    ++((CountingState *) state)->count;
+    return malloc(size);
+}
+
+static void *counting_reallocate(void *state, void *ptr, size_t size) {
+    if (!ptr) {
+        ++((CountingState *) state)->allocated;
+        ++((CountingState *) state)->count;
+    }
+    return realloc(ptr, size);
+}
+
+static void counting_deallocate(void *state, void *ptr) {
+    if (ptr) {
+        --((CountingState *) state)->count;
+    }
+    free(ptr);
+}
+
+// All the memory comes from the allocator and goes back to it. Numbers in the arena take no allocations of their
+// own, and the ones created before it outlive its reset.
+static void test_allocator(void) {
+    LibintError err;
+    CountingState state = { 0, 0 };
+    LibintAllocator allocator = { counting_allocate, counting_reallocate, counting_deallocate, &state };
+    Libint *context;
+    err = libint_start_with_allocator(&context, &allocator);
+    assert(LIBINT_ERROR_OK == err);
+    assert(state.count);
+
+    const char *end_of_input;
+    const char *str = "123456789012345678901234567890123456789012345678901234567890";
+    LibintUnsigned *x;
+    err = libint_unsigned_from_string(context, &x, str, strlen(str), 10, &end_of_input);
+    assert(LIBINT_ERROR_OK == err);
+
+    err = libint_arena_begin(context, 1024);
+    assert(LIBINT_ERROR_OK == err);
+    for (int i = 0; i < 3; ++i) {
+        size_t allocated = state.allocated;
+        LibintUnsigned *square;
+        err = libint_unsigned_mul(context, &square, x, x);
+        assert(LIBINT_ERROR_OK == err);
+        LibintUnsigned *quotient;
+        err = libint_unsigned_div(context, &quotient, square, x);
+        assert(LIBINT_ERROR_OK == err);
+        int order;
+        err = libint_unsigned_compare(context, quotient, x, &order);
+        assert(LIBINT_ERROR_OK == err);
+        assert(!order);
+        err = libint_unsigned_add_replace(context, &quotient, square);
+        assert(LIBINT_ERROR_OK == err);
+        libint_unsigned_destroy(context, &square);
+        if (i) {
+            assert(allocated == state.allocated);
+        }
+        err = libint_arena_reset(context);
+        assert(LIBINT_ERROR_OK == err);
+    }
+    err = libint_arena_end(context);
+    assert(LIBINT_ERROR_OK == err);
+
+    // Numbers created before an arena keep their memory outside of it when they grow, are replaced or are copied.
+    LibintUnsigned *grown;
+    err = libint_unsigned_create(context, &grown, 1);
+    assert(LIBINT_ERROR_OK == err);
+    LibintUnsigned *replaced;
+    err = libint_unsigned_create(context, &replaced, 1);
+    assert(LIBINT_ERROR_OK == err);
+    // The divisor takes two words if they are 32 bits wide.
+    const uintmax_t divisor = ((uintmax_t) 1 << 40) + 12345;
+    LibintUnsigned *divided;
+    err = libint_unsigned_copy(context, &divided, x);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_arena_begin(context, 1024);
+    assert(LIBINT_ERROR_OK == err);
+    for (int i = 0; i < 3; ++i) {
+        err = libint_unsigned_add_replace(context, &grown, x);
+        assert(LIBINT_ERROR_OK == err);
+        err = libint_unsigned_mul_replace(context, &replaced, x);
+        assert(LIBINT_ERROR_OK == err);
+        err = libint_unsigned_div_mod_ui_replace(context, &divided, divisor, NULL);
+        assert(LIBINT_ERROR_OK == err);
+        LibintUnsigned *copy;
+        err = libint_unsigned_copy(context, &copy, grown);
+        assert(LIBINT_ERROR_OK == err);
+        err = libint_arena_reset(context);
+        assert(LIBINT_ERROR_OK == err);
+    }
+    err = libint_arena_end(context);
+    assert(LIBINT_ERROR_OK == err);
+    LibintUnsigned *expected;
+    err = libint_unsigned_mul_ui(context, &expected, x, 3);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_unsigned_add_ui_replace(context, &expected, 1);
+    assert(LIBINT_ERROR_OK == err);
+    int order;
+    err = libint_unsigned_compare(context, grown, expected, &order);
+    assert(LIBINT_ERROR_OK == err);
+    assert(!order);
+    libint_unsigned_destroy(context, &expected);
+    err = libint_unsigned_pow(context, &expected, x, 3);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_unsigned_compare(context, replaced, expected, &order);
+    assert(LIBINT_ERROR_OK == err);
+    assert(!order);
+    libint_unsigned_destroy(context, &expected);
+    err = libint_unsigned_copy(context, &expected, x);
+    assert(LIBINT_ERROR_OK == err);
+    for (int i = 0; i < 3; ++i) {
+        LibintUnsigned *quotient;
+        err = libint_unsigned_div_mod_ui(context, &quotient, expected, divisor, NULL);
+        assert(LIBINT_ERROR_OK == err);
+        libint_unsigned_destroy(context, &expected);
+        expected = quotient;
+    }
+    err = libint_unsigned_compare(context, divided, expected, &order);
+    assert(LIBINT_ERROR_OK == err);
+    assert(!order);
+    libint_unsigned_destroy(context, &expected);
+    libint_unsigned_destroy(context, &grown);
+    libint_unsigned_destroy(context, &replaced);
+    libint_unsigned_destroy(context, &divided);
+
+    // Division into a number that has room for the quotient allocates only the scratch of the division.
+    LibintUnsigned *square;
+    err = libint_unsigned_mul(context, &square, x, x);
+    assert(LIBINT_ERROR_OK == err);
+    LibintUnsigned *quotient;
+    err = libint_unsigned_create(context, &quotient, 0);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_unsigned_div_into(context, quotient, square, x);
+    assert(LIBINT_ERROR_OK == err);
+    size_t allocated = state.allocated;
+    err = libint_unsigned_div_into(context, quotient, square, x);
+    assert(LIBINT_ERROR_OK == err);
+    assert(allocated + 1 == state.allocated);
+    err = libint_unsigned_compare(context, quotient, x, &order);
+    assert(LIBINT_ERROR_OK == err);
+    assert(!order);
+    libint_unsigned_destroy(context, &square);
+    libint_unsigned_destroy(context, &quotient);
+
+    char *out;
+    size_t out_size;
+    err = libint_unsigned_to_string(context, x, 10, &out, &out_size);
+    assert(LIBINT_ERROR_OK == err);
+    assert(!strcmp(str, out));
+    free(out);
+
+    libint_unsigned_destroy(context, &x);
+    libint_finish(&context);
+    assert(!state.count);
+}
+
+static void test_small_values(void) {
+    LibintError err;
+    CountingState state = { 0, 0 };
+    LibintAllocator allocator = { counting_allocate, counting_reallocate, counting_deallocate, &state };
+    Libint *context;
+    err = libint_start_with_allocator(&context, &allocator);
+    assert(LIBINT_ERROR_OK == err);
+
+    // Values of up to two words are stored inline, so each result takes a single allocation.
+    size_t allocated = state.allocated;
+    LibintSigned *x;
+    err = libint_create(context, &x, -123456789);
+    assert(LIBINT_ERROR_OK == err);
+    LibintSigned *y;
+    err = libint_create(context, &y, 987654321);
+    assert(LIBINT_ERROR_OK == err);
+    LibintSigned *sum;
+    err = libint_add(context, &sum, x, y);
+    assert(LIBINT_ERROR_OK == err);
+    LibintSigned *product;
+    err = libint_mul(context, &product, x, y);
+    assert(LIBINT_ERROR_OK == err);
+    LibintSigned *square;
+    err = libint_sqr(context, &square, x);
+    assert(LIBINT_ERROR_OK == err);
+    assert(allocated + 5 == state.allocated);
+    intmax_t value;
+    err = libint_to_intmax(context, sum, &value);
+    assert(LIBINT_ERROR_OK == err);
+    assert(864197532 == value);
+    err = libint_to_intmax(context, product, &value);
+    assert(LIBINT_ERROR_OK == err);
+    assert(-121932631112635269 == value);
+    err = libint_to_intmax(context, square, &value);
+    assert(LIBINT_ERROR_OK == err);
+    assert(15241578750190521 == value);
+
+    allocated = state.allocated;
+    LibintUnsigned *a;
+    err = libint_unsigned_create(context, &a, UINT32_MAX);
+    assert(LIBINT_ERROR_OK == err);
+    LibintUnsigned *b;
+    err = libint_unsigned_add(context, &b, a, a);
+    assert(LIBINT_ERROR_OK == err);
+    assert(allocated + 2 == state.allocated);
+    LibintUnsigned *c;
+    err = libint_unsigned_mul(context, &c, b, b);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_unsigned_sub_replace(context, &c, b);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_unsigned_add_replace(context, &c, b);
+    assert(LIBINT_ERROR_OK == err);
+    LibintUnsigned *d;
+    err = libint_unsigned_sqr(context, &d, b);
+    assert(LIBINT_ERROR_OK == err);
+    assert_equal_unsigned(c, d);
+
+    libint_destroy(context, &x);
+    libint_destroy(context, &y);
+    libint_destroy(context, &sum);
+    libint_destroy(context, &product);
+    libint_destroy(context, &square);
+    libint_unsigned_destroy(context, &a);
+    libint_unsigned_destroy(context, &b);
+    libint_unsigned_destroy(context, &c);
+    libint_unsigned_destroy(context, &d);
+    libint_finish(&context);
+    assert(!state.count);
+}
+
+static void assert_equal_intmax(LibintSigned *x, intmax_t expected) {
+    intmax_t value;
+    LibintError err = libint_to_intmax(libint, x, &value);
+    assert(LIBINT_ERROR_OK == err);
+    assert(expected == value);
+}
+
+void test_div_euclid(intmax_t a, intmax_t b) {
+    assert(b);
+
+    LibintError err;
+
+    LibintSigned *x;
+    err = libint_create(libint, &x, a);
+    assert(LIBINT_ERROR_OK == err);
+
+    LibintSigned *y;
+    err = libint_create(libint, &y, b);
+    assert(LIBINT_ERROR_OK == err);
+
+    LibintSigned *q, *r;
+    err = libint_div_mod_euclid(libint, &q, &r, x, y);
+    assert(LIBINT_ERROR_OK == err);
+
+    intmax_t expected_quotient = a / b;
+    intmax_t expected_remainder = a % b;
+    if (expected_remainder < 0) {
+        expected_remainder += imaxabs(b);
+        expected_quotient += b < 0 ? 1 : -1;
+    }
+    assert_equal_intmax(q, expected_quotient);
+    assert_equal_intmax(r, expected_remainder);
+    libint_destroy(libint, &q);
+    libint_destroy(libint, &r);
+
+    err = libint_div_euclid(libint, &q, x, y);
+    assert(LIBINT_ERROR_OK == err);
+    assert_equal_intmax(q, expected_quotient);
+    err = libint_mod_euclid(libint, &r, x, y);
+    assert(LIBINT_ERROR_OK == err);
+    assert_equal_intmax(r, expected_remainder);
+
+    libint_destroy(libint, &x);
+    libint_destroy(libint, &y);
+    libint_destroy(libint, &q);
+    libint_destroy(libint, &r);
+}
+
+static void test_scalar(intmax_t a, intmax_t b) {
+    LibintError err;
+
+    LibintSigned *x;
+    err = libint_create(libint, &x, a);
+    assert(LIBINT_ERROR_OK == err);
+
+    LibintSigned *result;
+    err = libint_add_si(libint, &result, x, b);
+    assert(LIBINT_ERROR_OK == err);
+    assert_equal_intmax(result, a + b);
+    libint_destroy(libint, &result);
+
+    err = libint_sub_si(libint, &result, x, b);
+    assert(LIBINT_ERROR_OK == err);
+    assert_equal_intmax(result, a - b);
+    libint_destroy(libint, &result);
+
+    err = libint_mul_si(libint, &result, x, b);
+    assert(LIBINT_ERROR_OK == err);
+    assert_equal_intmax(result, a * b);
+    libint_destroy(libint, &result);
+
+    int order;
+    err = libint_compare_si(libint, x, b, &order);
+    assert(LIBINT_ERROR_OK == err);
+    assert((a > b) - (a < b) == (order > 0) - (order < 0));
+
+    uintmax_t remainder;
+    if (b) {
+        err = libint_div_mod_ui(libint, &result, x, imaxabs(b), &remainder);
+        assert(LIBINT_ERROR_OK == err);
+        assert(remainder < (uintmax_t) imaxabs(b));
+        intmax_t quotient;
+        err = libint_to_intmax(libint, result, &quotient);
+        assert(LIBINT_ERROR_OK == err);
+        assert(quotient * imaxabs(b) + (intmax_t) remainder == a);
+        libint_destroy(libint, &result);
+    }
+    err = libint_div_mod_ui(libint, &result, x, UINTMAX_MAX, &remainder);
+    assert(LIBINT_ERROR_OK == err);
+    assert_equal_intmax(result, a < 0 ? -1 : 0);
+    assert(remainder == (a < 0 ? UINTMAX_MAX - (uintmax_t) -a : (uintmax_t) a));
+    libint_destroy(libint, &result);
+
+    err = libint_add_si_replace(libint, &x, b);
+    assert(LIBINT_ERROR_OK == err);
+    assert_equal_intmax(x, a + b);
+    err = libint_mul_si_replace(libint, &x, b);
+    assert(LIBINT_ERROR_OK == err);
+    assert_equal_intmax(x, (a + b) * b);
+    err = libint_sub_si_replace(libint, &x, b);
+    assert(LIBINT_ERROR_OK == err);
+    assert_equal_intmax(x, (a + b) * b - b);
+
+    libint_destroy(libint, &x);
+}
+
+// Operations with a machine integer give the same results as the ones with a number made of it.
+static void test_scalar_unsigned(size_t digits, uintmax_t y) {
+    LibintError err;
+
+    LibintUnsigned *x = random_unsigned(digits);
+    LibintUnsigned *y_number;
+    err = libint_unsigned_create(libint, &y_number, y);
+    assert(LIBINT_ERROR_OK == err);
+    LibintUnsigned *expected;
+    LibintUnsigned *actual;
+
+    err = libint_unsigned_add(libint, &expected, x, y_number);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_unsigned_add_ui(libint, &actual, x, y);
+    assert(LIBINT_ERROR_OK == err);
+    assert_equal_unsigned(expected, actual);
+    libint_unsigned_destroy(libint, &actual);
+    err = libint_unsigned_copy(libint, &actual, x);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_unsigned_add_ui_replace(libint, &actual, y);
+    assert(LIBINT_ERROR_OK == err);
+    assert_equal_unsigned(expected, actual);
+    err = libint_unsigned_sub_ui_replace(libint, &actual, y);
+    assert(LIBINT_ERROR_OK == err);
+    assert_equal_unsigned(x, actual);
+    libint_unsigned_destroy(libint, &actual);
+    err = libint_unsigned_sub_ui(libint, &actual, expected, y);
+    assert(LIBINT_ERROR_OK == err);
+    assert_equal_unsigned(x, actual);
+    libint_unsigned_destroy(libint, &actual);
+    libint_unsigned_destroy(libint, &expected);
+
+    err = libint_unsigned_mul(libint, &expected, x, y_number);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_unsigned_mul_ui(libint, &actual, x, y);
+    assert(LIBINT_ERROR_OK == err);
+    assert_equal_unsigned(expected, actual);
+    libint_unsigned_destroy(libint, &actual);
+    err = libint_unsigned_copy(libint, &actual, x);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_unsigned_mul_ui_replace(libint, &actual, y);
+    assert(LIBINT_ERROR_OK == err);
+    assert_equal_unsigned(expected, actual);
+    libint_unsigned_destroy(libint, &actual);
+    libint_unsigned_destroy(libint, &expected);
+
+    LibintUnsigned *expected_remainder;
+    err = libint_unsigned_div_mod(libint, &expected, &expected_remainder, x, y_number);
+    assert(LIBINT_ERROR_OK == err);
+    uintmax_t expected_remainder_value;
+    err = libint_unsigned_to_uintmax(libint, expected_remainder, &expected_remainder_value);
+    assert(LIBINT_ERROR_OK == err);
+    uintmax_t remainder;
+    err = libint_unsigned_div_mod_ui(libint, &actual, x, y, &remainder);
+    assert(LIBINT_ERROR_OK == err);
+    assert_equal_unsigned(expected, actual);
+    assert(expected_remainder_value == remainder);
+    libint_unsigned_destroy(libint, &actual);
+    err = libint_unsigned_copy(libint, &actual, x);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_unsigned_div_mod_ui_replace(libint, &actual, y, &remainder);
+    assert(LIBINT_ERROR_OK == err);
+    assert_equal_unsigned(expected, actual);
+    assert(expected_remainder_value == remainder);
+    libint_unsigned_destroy(libint, &actual);
+    libint_unsigned_destroy(libint, &expected);
+    libint_unsigned_destroy(libint, &expected_remainder);
+
+    int expected_order;
+    err = libint_unsigned_compare(libint, x, y_number, &expected_order);
+    assert(LIBINT_ERROR_OK == err);
+    int order;
+    err = libint_unsigned_compare_ui(libint, x, y, &order);
+    assert(LIBINT_ERROR_OK == err);
+    assert(expected_order == order);
+
+    libint_unsigned_destroy(libint, &x);
+    libint_unsigned_destroy(libint, &y_number);
+}
+
+// Random number with exactly digits hexadecimal digits, negative with probability 1/2.
+static LibintSigned *random_signed(size_t digits) {
+    static const char *hex = "0123456789ABCDEF";
+    char *str = malloc(digits + 1);
+    assert(str);
+    str[0] = rand() % 2 ? '-' : '+';
+    for (size_t i = 1; i <= digits; ++i) {
+        str[i] = hex[(i == 1) + rand() % (16 - (i == 1))];
+    }
+    LibintSigned *x;
+    const char *end_of_input;
+    LibintError err = libint_from_string(libint, &x, str, digits + 1, 16, &end_of_input);
+    assert(LIBINT_ERROR_OK == err);
+    free(str);
+    return x;
+}
+
+typedef LibintError (*SignedOperation)(Libint *libint, LibintSigned **out, LibintSigned *x, LibintSigned *y);
+typedef LibintError (*SignedIntoOperation)(Libint *libint, LibintSigned *out, LibintSigned *x, LibintSigned *y);
+typedef LibintError (*SignedDivModOperation)(
+        Libint *libint, LibintSigned **quotient, LibintSigned **remainder, LibintSigned *x, LibintSigned *y);
+
+static void assert_equal_signed(LibintSigned *x, LibintSigned *y) {
+    int order;
+    LibintError err = libint_compare(libint, x, y, &order);
+    assert(LIBINT_ERROR_OK == err);
+    assert(!order);
+}
+
+// Checks x = q * y + r, and that r is smaller than y in magnitude and has the sign of y for floor division or is
+// not negative for Euclidean division.
+static void test_div_mod_identity(size_t x_digits, size_t y_digits, SignedDivModOperation operation, bool is_floor) {
+    LibintError err;
+
+    LibintSigned *x = random_signed(x_digits);
+    LibintSigned *y = random_signed(y_digits);
+    int y_sign;
+    err = libint_compare_si(libint, y, 0, &y_sign);
+    assert(LIBINT_ERROR_OK == err);
+    int sign = is_floor ? y_sign : 1;
+    LibintSigned *q, *r;
+    err = operation(libint, &q, &r, x, y);
+    assert(LIBINT_ERROR_OK == err);
+
+    LibintSigned *actual;
+    err = libint_mul(libint, &actual, q, y);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_add_replace(libint, &actual, r);
+    assert(LIBINT_ERROR_OK == err);
+    assert_equal_signed(x, actual);
+
+    int order;
+    err = libint_compare_si(libint, r, 0, &order);
+    assert(LIBINT_ERROR_OK == err);
+    assert(order == 0 || order == sign);
+    LibintSigned *r_abs, *y_abs;
+    err = libint_copy(libint, &r_abs, r);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_copy(libint, &y_abs, y);
+    assert(LIBINT_ERROR_OK == err);
+    if (order < 0) {
+        err = libint_mul_si_replace(libint, &r_abs, -1);
+        assert(LIBINT_ERROR_OK == err);
+    }
+    if (y_sign < 0) {
+        err = libint_mul_si_replace(libint, &y_abs, -1);
+        assert(LIBINT_ERROR_OK == err);
+    }
+    err = libint_compare(libint, r_abs, y_abs, &order);
+    assert(LIBINT_ERROR_OK == err);
+    assert(order < 0);
+
+    libint_destroy(libint, &x);
+    libint_destroy(libint, &y);
+    libint_destroy(libint, &q);
+    libint_destroy(libint, &r);
+    libint_destroy(libint, &actual);
+    libint_destroy(libint, &r_abs);
+    libint_destroy(libint, &y_abs);
+}
+
+// Computing into a number gives the same result as the operation that allocates it, also when the number is an
+// operand.
+static void test_into(size_t x_digits, size_t y_digits, SignedOperation operation, SignedIntoOperation into) {
+    LibintError err;
+
+    LibintSigned *x = random_signed(x_digits);
+    LibintSigned *y = random_signed(y_digits);
+    LibintSigned *expected;
+    err = operation(libint, &expected, x, y);
+    assert(LIBINT_ERROR_OK == err);
+    LibintSigned *expected_same;
+    err = operation(libint, &expected_same, x, x);
+    assert(LIBINT_ERROR_OK == err);
+
+    LibintSigned *out;
+    err = libint_create(libint, &out, -1);
+    assert(LIBINT_ERROR_OK == err);
+    err = into(libint, out, x, y);
+    assert(LIBINT_ERROR_OK == err);
+    assert_equal_signed(expected, out);
+
+    err = libint_copy_into(libint, out, x);
+    assert(LIBINT_ERROR_OK == err);
+    err = into(libint, out, out, y);
+    assert(LIBINT_ERROR_OK == err);
+    assert_equal_signed(expected, out);
+
+    err = libint_copy_into(libint, out, y);
+    assert(LIBINT_ERROR_OK == err);
+    err = into(libint, out, x, out);
+    assert(LIBINT_ERROR_OK == err);
+    assert_equal_signed(expected, out);
+
+    err = libint_copy_into(libint, out, x);
+    assert(LIBINT_ERROR_OK == err);
+    err = into(libint, out, out, out);
+    assert(LIBINT_ERROR_OK == err);
+    assert_equal_signed(expected_same, out);
+
+    libint_destroy(libint, &x);
+    libint_destroy(libint, &y);
+    libint_destroy(libint, &expected);
+    libint_destroy(libint, &expected_same);
+    libint_destroy(libint, &out);
 }
 
-void test_str(intmax_t a) {
-    int base = 2 + rand() % (16 - 2);
+typedef LibintError (*UnsignedOperation)(Libint *libint, LibintUnsigned **out, LibintUnsigned *x, LibintUnsigned *y);
+typedef LibintError (*UnsignedIntoOperation)(
+        Libint *libint, LibintUnsigned *out, LibintUnsigned *x, LibintUnsigned *y);
 
+// Same as test_into, x must not be less than y for subtraction.
+static void test_unsigned_into(
+        size_t x_digits, size_t y_digits, UnsignedOperation operation, UnsignedIntoOperation into) {
     LibintError err;
 
-    LibintSigned *x;
-    err = libint_create(libint, &x, a);
+    LibintUnsigned *x = random_unsigned(x_digits);
+    LibintUnsigned *y = random_unsigned(y_digits);
+    err = libint_unsigned_add_ui_replace(libint, &y, 1);
+    assert(LIBINT_ERROR_OK == err);
+    LibintUnsigned *expected;
+    err = operation(libint, &expected, x, y);
+    if (LIBINT_ERROR_ARITHMETIC == err) {
+        libint_unsigned_destroy(libint, &x);
+        libint_unsigned_destroy(libint, &y);
+        return;
+    }
+    assert(LIBINT_ERROR_OK == err);
+    LibintUnsigned *expected_same;
+    err = libint_unsigned_add_ui_replace(libint, &x, 1);
+    assert(LIBINT_ERROR_OK == err);
+    err = operation(libint, &expected_same, x, x);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_unsigned_sub_ui_replace(libint, &x, 1);
     assert(LIBINT_ERROR_OK == err);
 
-    char *str;
-    size_t str_size;
-    err = libint_to_string(libint, x, base, &str, &str_size);
+    LibintUnsigned *out;
+    err = libint_unsigned_create(libint, &out, 1);
     assert(LIBINT_ERROR_OK == err);
+    err = into(libint, out, x, y);
+    assert(LIBINT_ERROR_OK == err);
+    assert_equal_unsigned(expected, out);
 
-    LibintSigned *parsed;
-    const char *end_of_input = NULL;
-    err = libint_from_string(libint, &parsed, str, str_size, base, &end_of_input);
+    err = libint_unsigned_copy_into(libint, out, x);
+    assert(LIBINT_ERROR_OK == err);
+    err = into(libint, out, out, y);
+    assert(LIBINT_ERROR_OK == err);
+    assert_equal_unsigned(expected, out);
+
+    err = libint_unsigned_copy_into(libint, out, y);
+    assert(LIBINT_ERROR_OK == err);
+    err = into(libint, out, x, out);
+    assert(LIBINT_ERROR_OK == err);
+    assert_equal_unsigned(expected, out);
+
+    err = libint_unsigned_copy_into(libint, out, x);
     assert(LIBINT_ERROR_OK == err);
+    err = libint_unsigned_add_ui_replace(libint, &out, 1);
+    assert(LIBINT_ERROR_OK == err);
+    err = into(libint, out, out, out);
+    assert(LIBINT_ERROR_OK == err);
+    assert_equal_unsigned(expected_same, out);
+
+    libint_unsigned_destroy(libint, &x);
+    libint_unsigned_destroy(libint, &y);
+    libint_unsigned_destroy(libint, &expected);
+    libint_unsigned_destroy(libint, &expected_same);
+    libint_unsigned_destroy(libint, &out);
+}
+
+// Copies share the buffer of the original, modifying one of them does not change the others.
+static void test_copy_on_write(size_t digits) {
+    LibintError err;
 
+    LibintUnsigned *x = random_unsigned(digits);
+    LibintUnsigned *y = random_unsigned(digits / 2 + 1);
     int order;
-    err = libint_compare(libint, x, parsed, &order);
+    err = libint_unsigned_compare(libint, x, y, &order);
+    assert(LIBINT_ERROR_OK == err);
+    LibintUnsigned *snapshot;
+    err = libint_unsigned_create(libint, &snapshot, 0);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_unsigned_copy_into(libint, snapshot, x);
     assert(LIBINT_ERROR_OK == err);
 
+    for (int operation = 0; operation < 7; ++operation) {
+        LibintUnsigned *copy;
+        err = libint_unsigned_copy(libint, &copy, x);
+        assert(LIBINT_ERROR_OK == err);
+        LibintUnsigned *other;
+        err = libint_unsigned_copy(libint, &other, copy);
+        assert(LIBINT_ERROR_OK == err);
+        LibintUnsigned *expected;
+        err = libint_unsigned_create(libint, &expected, 0);
+        assert(LIBINT_ERROR_OK == err);
+        err = libint_unsigned_copy_into(libint, expected, snapshot);
+        assert(LIBINT_ERROR_OK == err);
+        switch (operation) {
+        case 0:
+            err = libint_unsigned_add_replace(libint, &copy, y);
+            assert(LIBINT_ERROR_OK == err);
+            err = libint_unsigned_add_replace(libint, &expected, y);
+            break;
+        case 1:
+            if (order < 0) {
+                break;
+            }
+            err = libint_unsigned_sub_into(libint, copy, copy, y);
+            assert(LIBINT_ERROR_OK == err);
+            err = libint_unsigned_sub_replace(libint, &expected, y);
+            break;
+        case 2:
+            err = libint_unsigned_bitshift_replace(libint, &copy, 37);
+            assert(LIBINT_ERROR_OK == err);
+            err = libint_unsigned_bitshift_replace(libint, &expected, 37);
+            break;
+        case 3:
+            err = libint_unsigned_bitshift_replace(libint, &copy, -37);
+            assert(LIBINT_ERROR_OK == err);
+            err = libint_unsigned_bitshift_replace(libint, &expected, -37);
+            break;
+        case 4:
+            err = libint_unsigned_mul_ui_replace(libint, &copy, 12345);
+            assert(LIBINT_ERROR_OK == err);
+            err = libint_unsigned_mul_ui_replace(libint, &expected, 12345);
+            break;
+        case 5:
+            err = libint_unsigned_div_mod_ui_replace(libint, &copy, 12345, NULL);
+            assert(LIBINT_ERROR_OK == err);
+            err = libint_unsigned_div_mod_ui_replace(libint, &expected, 12345, NULL);
+            break;
+        case 6:
+            err = libint_unsigned_mul_into(libint, copy, copy, y);
+            assert(LIBINT_ERROR_OK == err);
+            err = libint_unsigned_mul_replace(libint, &expected, y);
+            break;
+        }
+        assert(LIBINT_ERROR_OK == err);
+        assert_equal_unsigned(expected, copy);
+        assert_equal_unsigned(snapshot, x);
+        assert_equal_unsigned(snapshot, other);
+        libint_unsigned_destroy(libint, &copy);
+        libint_unsigned_destroy(libint, &other);
+        libint_unsigned_destroy(libint, &expected);
+    }
+
+    // The copy outlives the original.
+    LibintUnsigned *copy;
+    err = libint_unsigned_copy(libint, &copy, x);
+    assert(LIBINT_ERROR_OK == err);
+    libint_unsigned_destroy(libint, &x);
+    err = libint_unsigned_add_ui_replace(libint, &copy, 0);
+    assert(LIBINT_ERROR_OK == err);
+    assert_equal_unsigned(snapshot, copy);
+
+    LibintSigned *a = random_signed(digits);
+    LibintSigned *b;
+    err = libint_copy(libint, &b, a);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_add_si_replace(libint, &b, 1);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_sub_si_replace(libint, &b, 1);
+    assert(LIBINT_ERROR_OK == err);
+    assert_equal_signed(a, b);
+    err = libint_mul_si_replace(libint, &b, -1);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_add_into(libint, b, b, a);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_compare_si(libint, b, 0, &order);
+    assert(LIBINT_ERROR_OK == err);
     assert(!order);
 
-    free(str);
+    libint_unsigned_destroy(libint, &copy);
+    libint_unsigned_destroy(libint, &y);
+    libint_unsigned_destroy(libint, &snapshot);
+    libint_destroy(libint, &a);
+    libint_destroy(libint, &b);
+}
+
+static void test_bitshift(size_t digits, int offset) {
+    LibintError err;
+
+    LibintUnsigned *x = random_unsigned(digits);
+    LibintUnsigned *two;
+    err = libint_unsigned_create(libint, &two, 2);
+    assert(LIBINT_ERROR_OK == err);
+    LibintUnsigned *power;
+    err = libint_unsigned_pow(libint, &power, two, (uintmax_t) offset);
+    assert(LIBINT_ERROR_OK == err);
+
+    LibintUnsigned *expected;
+    err = libint_unsigned_mul(libint, &expected, x, power);
+    assert(LIBINT_ERROR_OK == err);
+    LibintUnsigned *actual;
+    err = libint_unsigned_bitshift(libint, &actual, x, offset);
+    assert(LIBINT_ERROR_OK == err);
+    assert_equal_unsigned(expected, actual);
+
+    size_t x_msb, actual_msb;
+    err = libint_unsigned_most_significant_bit(libint, x, &x_msb);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_unsigned_most_significant_bit(libint, actual, &actual_msb);
+    assert(LIBINT_ERROR_OK == err);
+    assert(actual_msb == x_msb + (size_t) offset);
+
+    libint_unsigned_destroy(libint, &expected);
+    err = libint_unsigned_div(libint, &expected, x, power);
+    assert(LIBINT_ERROR_OK == err);
+    libint_unsigned_destroy(libint, &actual);
+    err = libint_unsigned_copy(libint, &actual, x);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_unsigned_bitshift_replace(libint, &actual, -offset);
+    assert(LIBINT_ERROR_OK == err);
+    assert_equal_unsigned(expected, actual);
+
+    // All bits are shifted out.
+    err = libint_unsigned_bitshift_replace(libint, &actual, -(int) x_msb - 1);
+    assert(LIBINT_ERROR_OK == err);
+    bool is_zero;
+    err = libint_unsigned_is_zero(libint, actual, &is_zero);
+    assert(LIBINT_ERROR_OK == err);
+    assert(is_zero);
+
+    libint_unsigned_destroy(libint, &x);
+    libint_unsigned_destroy(libint, &two);
+    libint_unsigned_destroy(libint, &power);
+    libint_unsigned_destroy(libint, &expected);
+    libint_unsigned_destroy(libint, &actual);
+}
+
+// Random words with many zeros and all-ones words, which make long carry chains.
+static void random_words(LibintWord *x, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+        int kind = rand() % 4;
+        x[i] = 0;
+        if (kind == 1) {
+            x[i] = (LibintWord) -1;
+        } else if (kind > 1) {
+            for (size_t j = 0; j < sizeof(LibintWord); ++j) {
+                x[i] = x[i] << CHAR_BIT | (LibintWord) (rand() & 0xFF);
+            }
+        }
+    }
+}
+
+// The kernels in use, which are the ones for the processor unless LIBINT_KERNELS=portable, must agree with the
+// portable ones, also when out is x.
+static void test_kernels(size_t x_size, size_t y_size) {
+    const LibintWordKernels *portable = &libint_words_portable_kernels;
+    LibintWord *x = malloc(sizeof(LibintWord) * (x_size + 1));
+    LibintWord *y = malloc(sizeof(LibintWord) * (y_size + 1));
+    LibintWord *expected = malloc(sizeof(LibintWord) * (x_size + 1));
+    LibintWord *actual = malloc(sizeof(LibintWord) * (x_size + 1));
+    assert(x && y && expected && actual);
+    random_words(x, x_size + 1);
+    random_words(y, y_size + 1);
+    LibintWord word = y[y_size];
+
+    LibintWord expected_carry = portable->add(expected, x, x_size, y, y_size);
+    assert(expected_carry == libint_words_add(actual, x, x_size, y, y_size));
+    assert(!memcmp(expected, actual, sizeof(LibintWord) * x_size));
+    memcpy(actual, x, sizeof(LibintWord) * x_size);
+    assert(expected_carry == libint_words_add(actual, actual, x_size, y, y_size));
+    assert(!memcmp(expected, actual, sizeof(LibintWord) * x_size));
+
+    expected_carry = portable->sub(expected, x, x_size, y, y_size);
+    assert(expected_carry == libint_words_sub(actual, x, x_size, y, y_size));
+    assert(!memcmp(expected, actual, sizeof(LibintWord) * x_size));
+    memcpy(actual, x, sizeof(LibintWord) * x_size);
+    assert(expected_carry == libint_words_sub(actual, actual, x_size, y, y_size));
+    assert(!memcmp(expected, actual, sizeof(LibintWord) * x_size));
+
+    expected_carry = portable->mul_word(expected, x, x_size, word);
+    assert(expected_carry == libint_words_mul_word(actual, x, x_size, word));
+    assert(!memcmp(expected, actual, sizeof(LibintWord) * x_size));
+    memcpy(actual, x, sizeof(LibintWord) * x_size);
+    assert(expected_carry == libint_words_mul_word(actual, actual, x_size, word));
+    assert(!memcmp(expected, actual, sizeof(LibintWord) * x_size));
+
+    memcpy(expected, x, sizeof(LibintWord) * (x_size + 1));
+    memcpy(actual, x, sizeof(LibintWord) * (x_size + 1));
+    expected_carry = portable->addmul_word(expected, y, y_size, x[x_size]);
+    assert(expected_carry == libint_words_addmul_word(actual, y, y_size, x[x_size]));
+    assert(!memcmp(expected, actual, sizeof(LibintWord) * y_size));
+
+    memcpy(expected, x, sizeof(LibintWord) * (x_size + 1));
+    memcpy(actual, x, sizeof(LibintWord) * (x_size + 1));
+    expected_carry = portable->submul_word(expected, y, y_size, x[x_size]);
+    assert(expected_carry == libint_words_submul_word(actual, y, y_size, x[x_size]));
+    assert(!memcmp(expected, actual, sizeof(LibintWord) * y_size));
+
+    free(x);
+    free(y);
+    free(expected);
+    free(actual);
+}
+
+// Vectorized comparison, normalization and shifts must agree with word by word loops for sizes around multiples of
+// the vector width, and the shifts also when out overlaps x in the direction they allow.
+static void test_words_vectors(size_t size) {
+    LibintWord *x = malloc(sizeof(LibintWord) * (size + 2));
+    LibintWord *y = malloc(sizeof(LibintWord) * (size + 2));
+    LibintWord *z = malloc(sizeof(LibintWord) * (size + 2));
+    LibintWord *expected = malloc(sizeof(LibintWord) * (size + 2));
+    assert(x && y && z && expected);
+    random_words(x, size);
+
+    // Zeros on top of a random number of words.
+    if (size) {
+        size_t zeros = (size_t) rand() % (size + 1);
+        memset(x + size - zeros, 0, sizeof(LibintWord) * zeros);
+        size_t expected_size = size;
+        while (expected_size > 1 && !x[expected_size - 1]) {
+            --expected_size;
+        }
+        assert(libint_words_normalized_size(x, size) == expected_size);
+    }
+
+    memcpy(y, x, sizeof(LibintWord) * size);
+    assert(!libint_words_compare(x, y, size));
+    if (size) {
+        size_t i = (size_t) rand() % size;
+        y[i] ^= (LibintWord) 1 << (rand() % (int) (sizeof(LibintWord) * CHAR_BIT));
+        int expected_order = x[i] < y[i] ? -1 : 1;
+        assert(libint_words_compare(x, y, size) == expected_order);
+        assert(libint_words_compare(y, x, size) == -expected_order);
+    }
+
+    random_words(x, size);
+    unsigned bits = 1 + (unsigned) rand() % (unsigned) (sizeof(LibintWord) * CHAR_BIT - 1);
+    unsigned back_bits = (unsigned) (sizeof(LibintWord) * CHAR_BIT) - bits;
+    LibintWord expected_shifted_out = size ? x[size - 1] >> back_bits : 0;
+    for (size_t i = 0; i < size; ++i) {
+        expected[i] = x[i] << bits | (i ? x[i - 1] >> back_bits : 0);
+    }
+    // Out of place, in place and with out one word above x.
+    for (size_t offset = 0; offset < 3; ++offset) {
+        memcpy(y, x, sizeof(LibintWord) * size);
+        LibintWord *out = offset == 0 ? z : y + offset - 1;
+        assert(libint_words_lshift(out, y, size, bits) == expected_shifted_out);
+        assert(!memcmp(out, expected, sizeof(LibintWord) * size));
+    }
+
+    expected_shifted_out = size ? x[0] << back_bits : 0;
+    for (size_t i = 0; i < size; ++i) {
+        expected[i] = x[i] >> bits | (i + 1 < size ? x[i + 1] << back_bits : 0);
+    }
+    // Out of place, in place and with out one word below x.
+    for (size_t offset = 0; offset < 3; ++offset) {
+        LibintWord *in = offset == 2 ? y + 1 : y;
+        memcpy(in, x, sizeof(LibintWord) * size);
+        LibintWord *out = offset == 0 ? z : y;
+        assert(libint_words_rshift(out, in, size, bits) == expected_shifted_out);
+        assert(!memcmp(out, expected, sizeof(LibintWord) * size));
+    }
+
+    free(x);
+    free(y);
+    free(z);
+    free(expected);
+}
+
+// Compares x^power mod modulus with binary exponentiation from the least significant bit of the power.
+static void test_powmod(size_t x_digits, size_t power_digits, size_t modulus_digits, bool is_odd) {
+    LibintError err;
+
+    LibintUnsigned *x = random_unsigned(x_digits);
+    LibintUnsigned *power = random_unsigned(power_digits);
+    LibintUnsigned *modulus = random_unsigned(modulus_digits);
+    err = libint_unsigned_mul_ui_replace(libint, &modulus, 2);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_unsigned_add_ui_replace(libint, &modulus, is_odd);
+    assert(LIBINT_ERROR_OK == err);
+
+    LibintUnsigned *actual;
+    err = libint_unsigned_powmod(libint, &actual, x, power, modulus);
+    assert(LIBINT_ERROR_OK == err);
+
+    LibintUnsigned *expected, *square;
+    err = libint_unsigned_create(libint, &expected, 1);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_unsigned_mod(libint, &square, x, modulus);
+    assert(LIBINT_ERROR_OK == err);
+    bool is_zero;
+    err = libint_unsigned_is_zero(libint, power, &is_zero);
+    assert(LIBINT_ERROR_OK == err);
+    while (!is_zero) {
+        uintmax_t remainder;
+        err = libint_unsigned_div_mod_ui_replace(libint, &power, 2, &remainder);
+        assert(LIBINT_ERROR_OK == err);
+        if (remainder) {
+            err = libint_unsigned_mul_into(libint, expected, expected, square);
+            assert(LIBINT_ERROR_OK == err);
+            err = libint_unsigned_mod_into(libint, expected, expected, modulus);
+            assert(LIBINT_ERROR_OK == err);
+        }
+        err = libint_unsigned_sqr_into(libint, square, square);
+        assert(LIBINT_ERROR_OK == err);
+        err = libint_unsigned_mod_into(libint, square, square, modulus);
+        assert(LIBINT_ERROR_OK == err);
+        err = libint_unsigned_is_zero(libint, power, &is_zero);
+        assert(LIBINT_ERROR_OK == err);
+    }
+    err = libint_unsigned_mod_into(libint, expected, expected, modulus);
+    assert(LIBINT_ERROR_OK == err);
+    assert_equal_unsigned(expected, actual);
+
+    libint_unsigned_destroy(libint, &x);
+    libint_unsigned_destroy(libint, &power);
+    libint_unsigned_destroy(libint, &modulus);
+    libint_unsigned_destroy(libint, &actual);
+    libint_unsigned_destroy(libint, &expected);
+    libint_unsigned_destroy(libint, &square);
+}
+
+static void test_montgomery(size_t digits) {
+    LibintError err;
+
+    LibintUnsigned *x = random_unsigned(digits);
+    LibintUnsigned *y = random_unsigned(digits / 2 + 1);
+    LibintUnsigned *modulus = random_unsigned(digits / 2 + 1);
+    err = libint_unsigned_mul_ui_replace(libint, &modulus, 2);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_unsigned_add_ui_replace(libint, &modulus, 1);
+    assert(LIBINT_ERROR_OK == err);
+    LibintMontgomery *montgomery;
+    err = libint_montgomery_create(libint, &montgomery, modulus);
+    assert(LIBINT_ERROR_OK == err);
+
+    LibintUnsigned *x_form, *y_form, *product, *actual;
+    err = libint_montgomery_to_form(libint, &x_form, x, montgomery);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_montgomery_to_form(libint, &y_form, y, montgomery);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_montgomery_mul(libint, &product, x_form, y_form, montgomery);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_montgomery_from_form(libint, &actual, product, montgomery);
+    assert(LIBINT_ERROR_OK == err);
+    LibintUnsigned *expected;
+    err = libint_unsigned_mul(libint, &expected, x, y);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_unsigned_mod_into(libint, expected, expected, modulus);
+    assert(LIBINT_ERROR_OK == err);
+    assert_equal_unsigned(expected, actual);
+    libint_unsigned_destroy(libint, &product);
+    libint_unsigned_destroy(libint, &actual);
+
+    err = libint_montgomery_sqr(libint, &product, x_form, montgomery);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_montgomery_from_form(libint, &actual, product, montgomery);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_unsigned_sqr_into(libint, expected, x);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_unsigned_mod_into(libint, expected, expected, modulus);
+    assert(LIBINT_ERROR_OK == err);
+    assert_equal_unsigned(expected, actual);
+
+    // Operands must be reduced.
+    libint_unsigned_destroy(libint, &product);
+    err = libint_montgomery_sqr(libint, &product, modulus, montgomery);
+    assert(LIBINT_ERROR_BAD_ARGUMENT == err);
+    err = libint_unsigned_add_ui_replace(libint, &modulus, 1);
+    assert(LIBINT_ERROR_OK == err);
+    LibintMontgomery *even;
+    err = libint_montgomery_create(libint, &even, modulus);
+    assert(LIBINT_ERROR_ARITHMETIC == err);
+
+    libint_unsigned_destroy(libint, &x);
+    libint_unsigned_destroy(libint, &y);
+    libint_unsigned_destroy(libint, &modulus);
+    libint_unsigned_destroy(libint, &x_form);
+    libint_unsigned_destroy(libint, &y_form);
+    libint_unsigned_destroy(libint, &actual);
+    libint_unsigned_destroy(libint, &expected);
+    libint_montgomery_destroy(libint, &montgomery);
+}
+
+static void test_barrett(size_t digits) {
+    LibintError err;
+
+    LibintUnsigned *modulus = random_unsigned(digits);
+    LibintBarrett *barrett;
+    err = libint_barrett_create(libint, &barrett, modulus);
+    assert(LIBINT_ERROR_OK == err);
+
+    // Below B^(2 * k) and above it.
+    LibintUnsigned *x = random_unsigned(2 * digits);
+    LibintUnsigned *y = random_unsigned(3 * digits);
+    LibintUnsigned *expected, *actual;
+    err = libint_unsigned_mod(libint, &expected, y, modulus);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_barrett_mod(libint, &actual, y, barrett);
+    assert(LIBINT_ERROR_OK == err);
+    assert_equal_unsigned(expected, actual);
+    libint_unsigned_destroy(libint, &y);
+    y = actual;
+    libint_unsigned_destroy(libint, &expected);
+    err = libint_unsigned_mod(libint, &expected, x, modulus);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_barrett_mod(libint, &actual, x, barrett);
+    assert(LIBINT_ERROR_OK == err);
+    assert_equal_unsigned(expected, actual);
+    libint_unsigned_destroy(libint, &x);
+    x = actual;
+
+    err = libint_unsigned_add_into(libint, expected, x, y);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_unsigned_mod_into(libint, expected, expected, modulus);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_barrett_add(libint, &actual, x, y, barrett);
+    assert(LIBINT_ERROR_OK == err);
+    assert_equal_unsigned(expected, actual);
+    libint_unsigned_destroy(libint, &actual);
+
+    // x - y = (x + modulus - y) mod modulus.
+    err = libint_unsigned_add_into(libint, expected, x, modulus);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_unsigned_sub_into(libint, expected, expected, y);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_unsigned_mod_into(libint, expected, expected, modulus);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_barrett_sub(libint, &actual, x, y, barrett);
+    assert(LIBINT_ERROR_OK == err);
+    assert_equal_unsigned(expected, actual);
+    libint_unsigned_destroy(libint, &actual);
+
+    err = libint_unsigned_mul_into(libint, expected, x, y);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_unsigned_mod_into(libint, expected, expected, modulus);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_barrett_mul(libint, &actual, x, y, barrett);
+    assert(LIBINT_ERROR_OK == err);
+    assert_equal_unsigned(expected, actual);
+    libint_unsigned_destroy(libint, &actual);
+
+    err = libint_unsigned_sqr_into(libint, expected, x);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_unsigned_mod_into(libint, expected, expected, modulus);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_barrett_mul(libint, &actual, x, x, barrett);
+    assert(LIBINT_ERROR_OK == err);
+    assert_equal_unsigned(expected, actual);
+    libint_unsigned_destroy(libint, &actual);
+
+    LibintUnsigned *power = random_unsigned(1 + digits % 20);
+    libint_unsigned_destroy(libint, &expected);
+    err = libint_unsigned_powmod(libint, &expected, x, power, modulus);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_barrett_pow(libint, &actual, x, power, barrett);
+    assert(LIBINT_ERROR_OK == err);
+    assert_equal_unsigned(expected, actual);
+    libint_unsigned_destroy(libint, &actual);
+
+    err = libint_barrett_mul(libint, &actual, x, modulus, barrett);
+    assert(LIBINT_ERROR_BAD_ARGUMENT == err);
+
+    libint_unsigned_destroy(libint, &modulus);
+    libint_unsigned_destroy(libint, &x);
+    libint_unsigned_destroy(libint, &y);
+    libint_unsigned_destroy(libint, &expected);
+    libint_unsigned_destroy(libint, &power);
+    libint_barrett_destroy(libint, &barrett);
+}
+
+// Checks gcd, gcdext and invert of x and y against the Euclidean algorithm.
+static void check_gcd(LibintSigned *x, LibintSigned *y) {
+    LibintError err;
+
+    int x_sign, y_sign;
+    err = libint_compare_si(libint, x, 0, &x_sign);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_compare_si(libint, y, 0, &y_sign);
+    assert(LIBINT_ERROR_OK == err);
+    LibintSigned *expected, *remainder;
+    err = libint_mul_si(libint, &expected, x, x_sign < 0 ? -1 : 1);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_mul_si(libint, &remainder, y, y_sign < 0 ? -1 : 1);
+    assert(LIBINT_ERROR_OK == err);
+    bool is_zero;
+    err = libint_is_zero(libint, remainder, &is_zero);
+    assert(LIBINT_ERROR_OK == err);
+    while (!is_zero) {
+        err = libint_mod_trunc_into(libint, expected, expected, remainder);
+        assert(LIBINT_ERROR_OK == err);
+        LibintSigned *t = expected;
+        expected = remainder;
+        remainder = t;
+        err = libint_is_zero(libint, remainder, &is_zero);
+        assert(LIBINT_ERROR_OK == err);
+    }
+
+    LibintSigned *actual;
+    err = libint_gcd(libint, &actual, x, y);
+    assert(LIBINT_ERROR_OK == err);
+    assert_equal_signed(expected, actual);
+    libint_destroy(libint, &actual);
+
+    // gcd = s * x + t * y.
+    LibintSigned *s, *t, *sum;
+    err = libint_gcdext(libint, &actual, &s, &t, x, y);
+    assert(LIBINT_ERROR_OK == err);
+    assert_equal_signed(expected, actual);
+    err = libint_mul(libint, &sum, s, x);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_mul_into(libint, t, t, y);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_add_into(libint, sum, sum, t);
+    assert(LIBINT_ERROR_OK == err);
+    assert_equal_signed(expected, sum);
+    libint_destroy(libint, &actual);
+    libint_destroy(libint, &s);
+    libint_destroy(libint, &t);
+
+    // x * x^-1 mod y = 1 mod y.
+    int order;
+    err = libint_compare_si(libint, expected, 1, &order);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_invert(libint, &actual, x, y);
+    if (order) {
+        assert(LIBINT_ERROR_ARITHMETIC == err);
+    } else {
+        assert(LIBINT_ERROR_OK == err);
+        err = libint_compare_si(libint, actual, 0, &order);
+        assert(LIBINT_ERROR_OK == err);
+        assert(order >= 0);
+        err = libint_mul_into(libint, sum, actual, x);
+        assert(LIBINT_ERROR_OK == err);
+        err = libint_mod_euclid_into(libint, sum, sum, y);
+        assert(LIBINT_ERROR_OK == err);
+        err = libint_mod_euclid_into(libint, expected, expected, y);
+        assert(LIBINT_ERROR_OK == err);
+        assert_equal_signed(expected, sum);
+        libint_destroy(libint, &actual);
+    }
+
+    libint_destroy(libint, &expected);
+    libint_destroy(libint, &remainder);
+    libint_destroy(libint, &sum);
+}
+
+// Numbers with a random common factor of common_digits digits, or none if it is 0. half_gcd_threshold applies to
+// both the whole numbers and the recursion.
+static void test_gcd(size_t x_digits, size_t y_digits, size_t common_digits, size_t half_gcd_threshold) {
+    LibintError err;
+
+    size_t old_half_gcd_threshold, old_recursive_threshold;
+    err = libint_get_threshold(libint, LIBINT_THRESHOLD_GCD_HALF_GCD, &old_half_gcd_threshold);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_get_threshold(libint, LIBINT_THRESHOLD_HALF_GCD_RECURSIVE, &old_recursive_threshold);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_set_threshold(libint, LIBINT_THRESHOLD_GCD_HALF_GCD, half_gcd_threshold);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_set_threshold(libint, LIBINT_THRESHOLD_HALF_GCD_RECURSIVE, half_gcd_threshold);
+    assert(LIBINT_ERROR_OK == err);
+
+    LibintSigned *x = random_signed(x_digits);
+    LibintSigned *y = random_signed(y_digits);
+    if (common_digits) {
+        LibintSigned *common = random_signed(common_digits);
+        err = libint_mul_into(libint, x, x, common);
+        assert(LIBINT_ERROR_OK == err);
+        err = libint_mul_into(libint, y, y, common);
+        assert(LIBINT_ERROR_OK == err);
+        libint_destroy(libint, &common);
+    }
+    check_gcd(x, y);
+    check_gcd(y, x);
+
+    // The unsigned one is the same as the signed one of positive numbers.
+    LibintUnsigned *a = random_unsigned(x_digits);
+    LibintUnsigned *b = random_unsigned(y_digits);
+    LibintUnsigned *actual;
+    err = libint_unsigned_gcd(libint, &actual, a, b);
+    assert(LIBINT_ERROR_OK == err);
+    LibintUnsigned *remainder;
+    err = libint_unsigned_copy(libint, &remainder, b);
+    assert(LIBINT_ERROR_OK == err);
+    bool is_zero;
+    err = libint_unsigned_is_zero(libint, remainder, &is_zero);
+    assert(LIBINT_ERROR_OK == err);
+    while (!is_zero) {
+        err = libint_unsigned_mod_into(libint, a, a, remainder);
+        assert(LIBINT_ERROR_OK == err);
+        LibintUnsigned *t = a;
+        a = remainder;
+        remainder = t;
+        err = libint_unsigned_is_zero(libint, remainder, &is_zero);
+        assert(LIBINT_ERROR_OK == err);
+    }
+    assert_equal_unsigned(a, actual);
+
     libint_destroy(libint, &x);
-    libint_destroy(libint, &parsed);
+    libint_destroy(libint, &y);
+    libint_unsigned_destroy(libint, &a);
+    libint_unsigned_destroy(libint, &b);
+    libint_unsigned_destroy(libint, &actual);
+    libint_unsigned_destroy(libint, &remainder);
+    err = libint_set_threshold(libint, LIBINT_THRESHOLD_GCD_HALF_GCD, old_half_gcd_threshold);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_set_threshold(libint, LIBINT_THRESHOLD_HALF_GCD_RECURSIVE, old_recursive_threshold);
+    assert(LIBINT_ERROR_OK == err);
+}
+
+static void test_gcd_small(intmax_t a, intmax_t b) {
+    LibintError err;
+
+    LibintSigned *x, *y;
+    err = libint_create(libint, &x, a);
+    assert(LIBINT_ERROR_OK == err);
+    err = libint_create(libint, &y, b);
+    assert(LIBINT_ERROR_OK == err);
+    check_gcd(x, y);
+    libint_destroy(libint, &x);
+    libint_destroy(libint, &y);
 }
 
 void test(void) {
@@ -349,11 +2245,13 @@ void test(void) {
         if (b != 0) {
             test_div_floor(a, b);
             test_div_trunc(a, b);
+            test_div_euclid(a, b);
         }
         test_replace(a, b, libint_add_replace, imax_add);
         test_replace(a, b, libint_sub_replace, imax_sub);
         test_replace(a, b, libint_rsub_replace, imax_rsub);
         test_replace(a, b, libint_mul_replace, imax_mul);
+        test_scalar(a, b);
         a = imaxabs(a);
         b = imaxabs(b);
         if (b > a) {
@@ -373,6 +2271,118 @@ void test(void) {
         }
     }
 
+    for (size_t n = 1; n < 200; n += 7) {
+        test_mul_big_square_of_ones(n);
+    }
+    for (int i = 0; i < 20; ++i) {
+        test_mul_big(1 + rand() % 100, 1 + rand() % 100);
+    }
+    test_div_mod_add_back();
+    for (int i = 0; i < 50; ++i) {
+        test_copy_on_write(1 + rand() % 500);
+    }
+    for (int i = 0; i < 50; ++i) {
+        test_bitshift(1 + rand() % 300, rand() % 700);
+    }
+    for (size_t x_size = 0; x_size < 20; ++x_size) {
+        for (size_t y_size = 0; y_size <= x_size; ++y_size) {
+            test_kernels(x_size, y_size);
+        }
+    }
+    // Every size up to several blocks of four vectors, so that each tail length is reached.
+    for (size_t size = 0; size < 40; ++size) {
+        for (int i = 0; i < 5; ++i) {
+            test_words_vectors(size);
+        }
+    }
+    for (int i = 0; i < 50; ++i) {
+        size_t x_size = (size_t) rand() % 300;
+        test_kernels(x_size, x_size ? (size_t) rand() % (x_size + 1) : 0);
+    }
+    for (int i = 0; i < 50; ++i) {
+        test_montgomery(1 + rand() % 300);
+        test_barrett(1 + rand() % 300);
+        test_powmod(1 + rand() % 100, 1 + rand() % (i < 25 ? 4 : 60), 1 + rand() % (i < 25 ? 20 : 200), i % 2);
+    }
+    // Past the Toom-3 threshold, where Barrett reduction uses full products.
+    test_barrett(2100);
+    // Power 0 and modulus 1.
+    test_powmod(5, 0, 1, true);
+    test_powmod(5, 3, 0, true);
+    for (int i = 0; i < 50; ++i) {
+        test_gcd(1 + rand() % 300, 1 + rand() % 300, rand() % 100, 768);
+        test_gcd(1 + rand() % 300, 1 + rand() % 300, rand() % 100, 4);
+    }
+    test_gcd(3000, 3000, 0, 4);
+    test_gcd(2000, 1000, 500, 16);
+    test_gcd_small(0, 0);
+    test_gcd_small(0, -7);
+    test_gcd_small(-12, 0);
+    test_gcd_small(1, 1);
+    test_gcd_small(3, -1);
+    test_gcd_small(-18, 12);
+    test_gcd_small(INTMAX_MIN, 6);
+    for (int i = 0; i < 50; ++i) {
+        size_t x_digits = 1 + rand() % (i < 25 ? 40 : 1000);
+        size_t y_digits = 1 + rand() % (i < 25 ? 40 : 1000);
+        test_into(x_digits, y_digits, libint_add, libint_add_into);
+        test_into(x_digits, y_digits, libint_sub, libint_sub_into);
+        test_into(x_digits, y_digits, libint_mul, libint_mul_into);
+        test_into(x_digits, y_digits, libint_div_trunc, libint_div_trunc_into);
+        test_into(x_digits, y_digits, libint_mod_trunc, libint_mod_trunc_into);
+        test_into(x_digits, y_digits, libint_div_floor, libint_div_floor_into);
+        test_into(x_digits, y_digits, libint_mod_floor, libint_mod_floor_into);
+        test_into(x_digits, y_digits, libint_div_euclid, libint_div_euclid_into);
+        test_into(x_digits, y_digits, libint_mod_euclid, libint_mod_euclid_into);
+        test_div_mod_identity(x_digits, y_digits, libint_div_mod_floor, true);
+        test_div_mod_identity(x_digits, y_digits, libint_div_mod_euclid, false);
+        test_unsigned_into(x_digits, y_digits, libint_unsigned_add, libint_unsigned_add_into);
+        test_unsigned_into(x_digits, y_digits, libint_unsigned_sub, libint_unsigned_sub_into);
+        test_unsigned_into(x_digits, y_digits, libint_unsigned_mul, libint_unsigned_mul_into);
+        test_unsigned_into(x_digits, y_digits, libint_unsigned_div, libint_unsigned_div_into);
+        test_unsigned_into(x_digits, y_digits, libint_unsigned_mod, libint_unsigned_mod_into);
+    }
+    for (int i = 0; i < 100; ++i) {
+        uintmax_t y = ((uintmax_t) rand() << 32 | (uintmax_t) rand()) >> (rand() % 64);
+        test_scalar_unsigned(1 + rand() % 40, y ? y : 1);
+        test_scalar_unsigned(1 + rand() % 40, UINTMAX_MAX - (uintmax_t) rand());
+    }
+    for (int i = 0; i < 200; ++i) {
+        LibintWord y = (LibintWord) rand() << (rand() % 24);
+        test_div_mod_word(1 + rand() % 200, y ? y : 1);
+        test_div_mod_word(1 + rand() % 200, (LibintWord) -1 - (LibintWord) rand());
+    }
+    for (int i = 0; i < 200; ++i) {
+        test_div_mod_big(1 + rand() % 300, 1 + rand() % 150);
+    }
+    for (int i = 0; i < 50; ++i) {
+        test_div_algorithms(1 + rand() % 3000, 1 + rand() % 1500);
+    }
+    for (int i = 0; i < 20; ++i) {
+        test_divider(1 + rand() % 16, 48, 16384, 256);
+        test_divider(1 + rand() % 1000, 48, 16384, 256);
+        test_divider(1 + rand() % 1000, 2, 3, 3);
+        test_divider(1 + rand() % 1000, 4, 17, 17);
+        test_divider(1 + rand() % 1000, 4, SIZE_MAX, 5);
+        test_divider(1 + rand() % 4000, 48, SIZE_MAX, 24);
+    }
+    test_allocator();
+    test_small_values();
+    for (int i = 0; i < 100; ++i) {
+        test_replace_in_place(1 + rand() % 200, 1 + rand() % 8);
+    }
+    for (int i = 0; i < 50; ++i) {
+        test_str_big(1 + rand() % 2000, 2 + rand() % (16 - 2 + 1));
+    }
+    for (int i = 0; i < 50; ++i) {
+        test_mul_algorithms(1 + rand() % 2000, 1 + rand() % 2000);
+        test_sqr_algorithms(1 + rand() % 2000);
+    }
+    // Unbalanced operands that are transformed together rather than chunk by chunk.
+    for (int i = 0; i < 10; ++i) {
+        test_mul_algorithms(4000 + rand() % 4000, 1 + rand() % 100);
+    }
+
     libint_finish(&libint);
 }
 